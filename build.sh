@@ -20,12 +20,6 @@ if [ x"$hostname" == x"cifarm-ubuntu-node"  ]; then
         export PATH="/opt/bin:$PATH"
 fi
 
-# Check if libHilbert is installed
-
-if [ ! -d $HOME/openfpm_dependencies/openfpm_data/LIBHILBERT ]; then
-	./install_LIBHILBERT.sh $HOME/openfpm_dependencies/openfpm_data/ 4
-fi
-
 if [ ! -d $HOME/openfpm_dependencies/openfpm_data/VCDEVEL ]; then
         ./install_VCDEVEL.sh $HOME/openfpm_dependencies/openfpm_data/ 4
 fi
@@ -56,7 +50,7 @@ cd "$workspace/openfpm_data"
 pre_command=""
 sh ./autogen.sh
 options="$options --disable-gpu "
-options="$options --with-vcdevel=$HOME/openfpm_dependencies/openfpm_data/VCDEVEL --with-boost=$HOME/openfpm_dependencies/openfpm_data/BOOST  --with-libhilbert=$HOME/openfpm_dependencies/openfpm_data/LIBHILBERT --enable-cuda_on_cpu"
+options="$options --with-vcdevel=$HOME/openfpm_dependencies/openfpm_data/VCDEVEL --with-boost=$HOME/openfpm_dependencies/openfpm_data/BOOST --enable-cuda_on_cpu"
 
 if [ x"$3" == x"SE"  ]; then
   options="$options --enable-se-class1 --enable-se-class2 --enable-se-class3 --with-action-on-error=throw --enable-test-coverage"
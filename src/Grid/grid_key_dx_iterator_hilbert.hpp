@@ -8,10 +8,7 @@
 #ifndef OPENFPM_DATA_SRC_GRID_GRID_KEY_DX_ITERATOR_HILBERT_HPP_
 #define OPENFPM_DATA_SRC_GRID_GRID_KEY_DX_ITERATOR_HILBERT_HPP_
 
-extern "C"
-{
-#include "hilbertKey.h"
-}
+#include "util/hilbert.hpp"
 
 
 /*
@@ -88,20 +85,10 @@ public:
 
 	grid_key_dx_iterator_hilbert<dim> & operator++()
 	{
-		//An integer to handle errors
-		int err;
-
 		hkey++;
 
-		//Array to handle output
-		uint64_t nextCoord[dim];
-
 		//Get the coordinates of the next cell
-		getIntCoordFromHKey(nextCoord, m, dim, hkey, &err);
-
-		//Set the new coordinates
-		for (size_t i = 0; i < dim; i++)
-			gk.set_d(i, nextCoord[i]);
+		invlin_hid(hkey,m,gk);
 
 		return *this;
 	}
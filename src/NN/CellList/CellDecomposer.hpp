@@ -12,6 +12,12 @@
 #include "Space/Matrix.hpp"
 #include "util/copy_compare/meta_compare.hpp"
 #include "Grid/grid_sm.hpp"
+#if !defined(__NVCC__) || defined(CUDA_ON_CPU)
+#include <Vc/Vc>
+#define CELL_DECOMPOSER_BATCH_VC
+#endif
+#include <cmath>
+#include <type_traits>
 
 #define CELL_DECOMPOSER 8001lu
 
@@ -504,6 +510,90 @@ public:
 	}
 };
 
+/*! \brief Convert a block of coordinates into cell coordinates, scalar implementation
+ *
+ * \tparam T type of space
+ * \tparam vc true when a Vc vector exist for T
+ *
+ */
+template<typename T, bool vc>
+struct cd_batch_impl
+{
+	/*! \brief Convert a block of coordinates into cell coordinates
+	 *
+	 * c[i] = floor((x[i] - o) / h) + off, the values outside [0,hi] are set to hi like
+	 * ConvertToID does (negative values wrap-around in size_t)
+	 *
+	 * \param x coordinates
+	 * \param n number of coordinates
+	 * \param o origin
+	 * \param h cell spacing
+	 * \param off padding
+	 * \param hi highest cell coordinate
+	 * \param c cell coordinates (output, integer values)
+	 *
+	 */
+	static inline void convert(const T * x, size_t n, T o, T h, T off, T hi, T * c)
+	{
+		for (size_t i = 0 ; i < n ; i++)
+		{
+			T id = std::floor((x[i] - o) / h) + off;
+			c[i] = (id < 0 || id > hi)?hi:id;
+		}
+	}
+};
+
+#ifdef CELL_DECOMPOSER_BATCH_VC
+
+/*! \brief Convert a block of coordinates into cell coordinates, Vc implementation
+ *
+ * \tparam T type of space (float or double)
+ *
+ */
+template<typename T>
+struct cd_batch_impl<T,true>
+{
+	//! Vc vector
+	typedef Vc::Vector<T> vT;
+
+	/*! \brief Convert a block of coordinates into cell coordinates
+	 *
+	 * c[i] = floor((x[i] - o) / h) + off, the values outside [0,hi] are set to hi like
+	 * ConvertToID does. The division is kept (instead of the multiplication by the inverse)
+	 * so that the result is the same of getCell
+	 *
+	 * \param x coordinates
+	 * \param n number of coordinates
+	 * \param o origin
+	 * \param h cell spacing
+	 * \param off padding
+	 * \param hi highest cell coordinate
+	 * \param c cell coordinates (output, integer values)
+	 *
+	 */
+	static inline void convert(const T * x, size_t n, T o, T h, T off, T hi, T * c)
+	{
+		vT vo(o);
+		vT vh(h);
+		vT voff(off);
+		vT vlo(Vc::Zero);
+		vT vhi(hi);
+
+		size_t i = 0;
+		for ( ; i + vT::Size <= n ; i += vT::Size)
+		{
+			vT id = Vc::floor((vT(&x[i],Vc::Unaligned) - vo) / vh) + voff;
+			id = Vc::min(id,vhi);
+			id(id < vlo) = vhi;
+			id.store(&c[i],Vc::Unaligned);
+		}
+
+		cd_batch_impl<T,false>::convert(&x[i],n-i,o,h,off,hi,&c[i]);
+	}
+};
+
+#endif
+
 /*! \brief Decompose a space into cells
  *
  * It is a convenient class for cell decomposition of an N dimensional space into cells
@@ -1280,6 +1370,87 @@ public:
 		return cell_id;
 	}
 
+	/*! \brief Get the cell-id of a contiguous range of particles
+	 *
+	 * Equivalent to calling getCell on every position, but the positions are processed in
+	 * blocks one dimension at the time, so that the conversion into cell coordinates is done
+	 * with SIMD instructions (Vc, scalar fallback for types that Vc does not support). The
+	 * positions can be stored in an AoS or SoA vector. As in getCell, points outside the padding
+	 * (below or above) go into the last cell of the dimension
+	 *
+	 * \param pos vector of positions (property 0)
+	 * \param start first particle
+	 * \param stop one past the last particle
+	 * \param cells cell-id of the particles (output, cells[i - start] for the particle i)
+	 *
+	 */
+	template<typename vector_pos, typename id_type>
+	void getCellBatch(const vector_pos & pos, size_t start, size_t stop, id_type * cells) const
+	{
+#ifdef SE_CLASS1
+		if (tot_n_cell == 0)
+		{
+			std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " using an uninitialized CellDecomposer";
+			ACTION_ON_ERROR(CELL_DECOMPOSER);
+		}
+#endif
+
+		typedef cd_batch_impl<T,std::is_same<T,float>::value || std::is_same<T,double>::value> impl;
+
+		const size_t blk = 256;
+
+		T x[blk];
+		T c[blk];
+
+		// all the transformations are a shift, the origin is obtained transforming the zero point
+
+		Point<dim,T> zero;
+		zero.zero();
+
+		T o[dim];
+		for (size_t s = 0 ; s < dim ; s++)
+		{o[s] = - t.transform(zero,s);}
+
+		for (size_t b = start ; b < stop ; b += blk)
+		{
+			size_t n = (stop - b < blk)?(stop - b):blk;
+			id_type * cb = &cells[b - start];
+
+			for (size_t s = 0 ; s < dim ; s++)
+			{
+				for (size_t i = 0 ; i < n ; i++)
+				{x[i] = pos.template get<0>(b + i)[s];}
+
+#ifdef SE_CLASS1
+				for (size_t i = 0 ; i < n ; i++)
+				{
+					if (x[i] < box.getLow(s) - off[s]*box_unit.getP2()[s] || x[i] > box.getHigh(s) + off[s]*box_unit.getP2()[s])
+					{
+						std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " particle " << b + i << " is not inside the cell space";
+						ACTION_ON_ERROR(CELL_DECOMPOSER);
+					}
+				}
+#endif
+
+				impl::convert(x,n,o[s],box_unit.getHigh(s),off[s],gr_cell.size(s)-1,c);
+
+				size_t stride = (s == 0)?1:gr_cell2.size_s(s-1);
+				size_t sh = cell_shift.get(s);
+
+				if (s == 0)
+				{
+					for (size_t i = 0 ; i < n ; i++)
+					{cb[i] = (size_t)c[i] - sh;}
+				}
+				else
+				{
+					for (size_t i = 0 ; i < n ; i++)
+					{cb[i] += stride * ((size_t)c[i] - sh);}
+				}
+			}
+		}
+	}
+
 	/*! \brief Return the smallest box containing the grid points
 	 *
 	 * Suppose a grid 5x5 defined on a Box<2,float> box({0.0,0.0},{1.0,1.0})
@@ -288,6 +288,127 @@ BOOST_AUTO_TEST_CASE( CellDecomposer_swap_use )
 	BOOST_REQUIRE(cd1 == cd2_old);
 }
 
+/*! \brief Check getCellBatch against getCell on AoS and SoA positions
+ *
+ * \param cd Cell decomposer
+ * \param dom domain covered by the cells (padding included)
+ *
+ */
+template<typename T, typename CellDecomposer_type>
+void Test_cell_batch(const CellDecomposer_type & cd, const Box<3,T> & dom)
+{
+	std::default_random_engine g;
+	std::uniform_real_distribution<T> d(0.0,1.0);
+
+	openfpm::vector<Point<3,T>> pos;
+	openfpm::vector<aggregate<T[3]>,HeapMemory,memory_traits_inte> pos_soa;
+
+	// an odd number of points so that the SIMD tail is used
+
+	for (size_t i = 0 ; i < 1001 ; i++)
+	{
+		pos.add();
+		pos_soa.add();
+
+		for (size_t j = 0 ; j < 3 ; j++)
+		{
+			T x = dom.getLow(j) + d(g)*(dom.getHigh(j) - dom.getLow(j));
+			pos.template get<0>(pos.size()-1)[j] = x;
+			pos_soa.template get<0>(pos_soa.size()-1)[j] = x;
+		}
+	}
+
+	openfpm::vector<size_t> cells(pos.size());
+	openfpm::vector<size_t> cells_soa(pos.size());
+
+	cd.getCellBatch(pos,0,pos.size(),&cells.get(0));
+	cd.getCellBatch(pos_soa,0,pos.size(),&cells_soa.get(0));
+
+	bool ret = true;
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{
+		ret &= cells.get(i) == cd.getCell(Point<3,T>(pos.get(i)));
+		ret &= cells_soa.get(i) == cells.get(i);
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+
+	// a sub-range
+
+	openfpm::vector<unsigned int> cells_sub(100);
+	cd.getCellBatch(pos,500,600,&cells_sub.get(0));
+
+	for (size_t i = 0 ; i < 100 ; i++)
+	{ret &= cells_sub.get(i) == cells.get(500+i);}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+}
+
+BOOST_AUTO_TEST_CASE( CellDecomposer_get_cell_batch )
+{
+	size_t div[3] = {16,15,7};
+
+	SpaceBox<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	Point<3,double> sht({1.1,-2.1,3.1});
+	SpaceBox<3,double> box2 = box;
+	box2 += sht;
+
+	// the padding cells extend the domain by one cell spacing (two for cd2)
+
+	Box<3,double> dom({-1.0/16,-1.0/15,-1.0/7},{1.0+1.0/16,1.0+1.0/15,1.0+1.0/7});
+	Box<3,double> dom2({-2.0/16,-2.0/15,-2.0/7},{1.0+2.0/16,1.0+2.0/15,1.0+2.0/7});
+	Box<3,double> dom_sht = dom;
+	dom_sht += sht;
+
+	CellDecomposer_sm< 3,double,shift<3,double> > cd(box2,div,1);
+	Test_cell_batch<double>(cd,dom_sht);
+
+	CellDecomposer_sm< 3,double > cd2(box,div,2);
+	Test_cell_batch<double>(cd2,dom2);
+
+	SpaceBox<3,float> boxf({0.0,0.0,0.0},{1.0,1.0,1.0});
+	Box<3,float> domf({-1.0/16,-1.0/15,-1.0/7},{1.0+1.0/16,1.0+1.0/15,1.0+1.0/7});
+
+	CellDecomposer_sm< 3,float,shift<3,float> > cdf(boxf,div,1);
+	Test_cell_batch<float>(cdf,domf);
+
+	CellDecomposer_sm< 3,float > cdf2(boxf,div,1);
+	Test_cell_batch<float>(cdf2,domf);
+
+	// decomposer with a cell shift
+
+	Box<3,size_t> ext({1,2,3},{1,1,1});
+	CellDecomposer_sm< 3,double,shift<3,double> > cd3(cd,ext);
+	Test_cell_batch<double>(cd3,dom_sht);
+
+#ifndef SE_CLASS1
+
+	// points outside the padding go into the last cell of the dimension, like getCell
+
+	openfpm::vector<Point<3,double>> out;
+	out.add(Point<3,double>({-0.5,0.5,0.5}));
+	out.add(Point<3,double>({1.5,0.5,0.5}));
+	out.add(Point<3,double>({0.5,-3.0,2.0}));
+
+	size_t c[3];
+	cd2.getCellBatch(out,0,out.size(),c);
+
+	// cd2 has 20x19x11 cells (padding 2), the point (0.5,0.5,0.5) is in the cell (10,9,5)
+
+	grid_key_dx<3> k0({19,9,5});
+	grid_key_dx<3> k1({19,9,5});
+	grid_key_dx<3> k2({10,18,10});
+
+	BOOST_REQUIRE_EQUAL(c[0],cd2.getGrid().LinId(k0));
+	BOOST_REQUIRE_EQUAL(c[1],cd2.getGrid().LinId(k1));
+	BOOST_REQUIRE_EQUAL(c[2],cd2.getGrid().LinId(k2));
+
+	for (size_t i = 0 ; i < out.size() ; i++)
+	{BOOST_REQUIRE_EQUAL(c[i],cd2.getCell(Point<3,double>(out.get(i))));}
+
+#endif
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLDECOMPOSER_UNIT_TESTS_HPP_ */
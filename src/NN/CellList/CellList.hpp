@@ -14,9 +14,13 @@
 #include "Space/SpaceBox.hpp"
 #include "util/mathutil.hpp"
 #include "CellNNIterator.hpp"
+#include "CellNNIteratorPeriodic.hpp"
 #include "Space/Shape/HyperCube.hpp"
 #include "CellListNNIteratorRadius.hpp"
 #include <unordered_map>
+#include <memory>
+#include <limits>
+#include <algorithm>
 
 #include "CellListIterator.hpp"
 #include "ParticleIt_Cells.hpp"
@@ -26,12 +30,16 @@
 #include "NN/Mem_type/MemFast.hpp"
 #include "NN/Mem_type/MemBalanced.hpp"
 #include "NN/Mem_type/MemMemoryWise.hpp"
+#include "NN/Mem_type/MemCompact.hpp"
 #include "NN/CellList/NNc_array.hpp"
+#include "hash_map/hopscotch_map.h"
+#include "util/zmorton.hpp"
+#include "util/hilbert.hpp"
 #include "cuda/CellList_cpu_ker.cuh"
 
-//! Wrapper of the unordered map
+//! Wrapper of the unordered map (open addressing, no allocation per element)
 template<typename key,typename val>
-class wrap_unordered_map: public std::unordered_map<key,val>
+class wrap_unordered_map: public tsl::hopscotch_map<key,val>
 {
 };
 
@@ -48,6 +56,46 @@ class wrap_unordered_map<boost::multiprecision::float128,val>
 
 #endif
 
+/*! \brief Morton key of a cell
+ *
+ * \tparam dim dimensionality
+ * \tparam has_zid true when util/zmorton.hpp implement the dimension
+ *
+ */
+template<unsigned int dim, bool has_zid = (dim <= 3)>
+struct cl_morton_key
+{
+	/*! \brief Return the Morton key of a cell
+	 *
+	 * \param key cell
+	 *
+	 * \return the key
+	 *
+	 */
+	static inline size_t get(const grid_key_dx<dim> & key)
+	{
+		return lin_zid(key);
+	}
+};
+
+//! Morton key of a cell, generic bit interleaving for dim > 3
+template<unsigned int dim>
+struct cl_morton_key<dim,false>
+{
+	static inline size_t get(const grid_key_dx<dim> & key)
+	{
+		size_t zid = 0;
+
+		for (size_t b = 0 ; b < (sizeof(size_t)*8) / dim ; b++)
+		{
+			for (size_t d = 0 ; d < dim ; d++)
+			{zid |= (((size_t)key.get(d) >> b) & 1) << (b*dim + d);}
+		}
+
+		return zid;
+	}
+};
+
 //! Point at witch the cell do a reallocation (it should the the maximum for all the implementations)
 #define CELL_REALLOC 16ul
 
@@ -305,6 +353,8 @@ void NNcalc_rad(T r_cut, openfpm::vector<long int> & NNcell, const Box<dim,T> &
  *
  */
 
+template<typename CellList_type> class CellList_cpu_reorder;
+
 /*! \brief Class for FAST cell list implementation
  *
  * This class implement the FAST cell list, fast but memory
@@ -341,6 +391,11 @@ void NNcalc_rad(T r_cut, openfpm::vector<long int> & NNcell, const Box<dim,T> &
  * \tparam dim Dimensionality of the space
  * \tparam T type of the space float, double ...
  * \tparam base Base structure that store the information
+ * \tparam cl_order order of the cells in memory CL_CELL_ORDER_LINEAR, CL_CELL_ORDER_MORTON or CL_CELL_ORDER_HILBERT.
+ *         With Morton (Hilbert) the cells are stored following the curve, the neighborhood cells of a cell
+ *         are in general close in memory also along the last dimension. The cell ids (getCell, getNNIterator,
+ *         get(cell,ele) ...) do not change, only the position of the cells inside the memory structure.
+ *         The kernel view (toKernel) access the cells by position in memory, it support only CL_CELL_ORDER_LINEAR
  *
  * ### Declaration of a cell list
  * \snippet CellList_test.hpp Declare a cell list
@@ -352,9 +407,12 @@ void NNcalc_rad(T r_cut, openfpm::vector<long int> & NNcell, const Box<dim,T> &
  * \snippet CellList_test.hpp Usage of the neighborhood iterator
  *
  */
-template<unsigned int dim, typename T,  typename Mem_type, typename transform = no_transform<dim,T>, typename vector_pos_type = openfpm::vector<Point<dim,T>>>
+template<unsigned int dim, typename T,  typename Mem_type, typename transform = no_transform<dim,T>, typename vector_pos_type = openfpm::vector<Point<dim,T>>, unsigned int cl_order = CL_CELL_ORDER_LINEAR>
 class CellList : public CellDecomposer_sm<dim,T,transform>, public Mem_type
 {
+	//! The reorderer relabel the particles and must relabel part_cell too
+	template<typename CellList_type> friend class CellList_cpu_reorder;
+
 protected:
 	//! The array contain the neighborhood of the cell-id in case of asymmetric interaction
 	//
@@ -375,8 +433,9 @@ protected:
 
 private:
 
-	//! Caching of r_cutoff radius
-	wrap_unordered_map<T,openfpm::vector<long int>> rcache;
+	//! Caching of r_cutoff radius (the neighborhoods are allocated separately so that
+	//! the references held by the iterators survive the rehash of the table)
+	wrap_unordered_map<T,std::unique_ptr<openfpm::vector<long int>>> rcache;
 
 	//! True if has been initialized from CellDecomposer
 	bool from_cd;
@@ -388,6 +447,146 @@ private:
 	//! Cells for the neighborhood radius
 	openfpm::vector<long int> nnc_rad;
 
+	//! Cell of each particle at the last fill() or update()
+	openfpm::vector<typename Mem_type::local_index_type> part_cell;
+
+	//! marker used at the last fill()
+	size_t fill_g_m = 0;
+
+	//! option used at the last fill()
+	size_t fill_opt = CL_NON_SYMMETRIC;
+
+	//! position in memory of every cell (empty when the cells are stored in row-major order)
+	openfpm::vector<typename Mem_type::local_index_type> cell_mem;
+
+	//! boundary conditions used by getNNIteratorPeriodic
+	size_t bc[dim] = {};
+
+	//! shift of the periodic images for every combination of crossed boundaries
+	Point<dim,T> p_shift[openfpm::math::pow(3,dim)];
+
+	/*! \brief Calculate the shift of the periodic images
+	 *
+	 * The shift k = sum_d (w_d + 1) * 3^d is the one of an image taken across the low (w_d = -1)
+	 * or the high (w_d = 1) boundary of the dimension d (w_d = 0 no boundary crossed)
+	 *
+	 */
+	void calcPeriodicShift()
+	{
+		const Box<dim,T> & dom = this->getDomain();
+
+		for (size_t k = 0 ; k < openfpm::math::pow(3,dim) ; k++)
+		{
+			for (size_t d = 0, kd = k ; d < dim ; d++, kd /= 3)
+			{
+				long int w = (long int)(kd % 3) - 1;
+				p_shift[k].get(d) = w * (dom.getHigh(d) - dom.getLow(d));
+			}
+		}
+	}
+
+	/*! \brief Return the position in memory of a cell
+	 *
+	 * \param cell cell id
+	 *
+	 * \return the position of the cell in the memory structure
+	 *
+	 */
+	inline size_t cellMem(size_t cell) const
+	{
+		if (cl_order == CL_CELL_ORDER_LINEAR)
+		{return cell;}
+
+		return cell_mem.get(cell);
+	}
+
+	/*! \brief Calculate the position in memory of every cell for the selected order
+	 *
+	 * The cells are ranked by their key on the space-filling curve, the ranks are
+	 * compact even when the grid is not a power of two
+	 *
+	 * \param div number of cells on each dimension (padding included)
+	 * \param tot_n_cell total number of cells
+	 *
+	 */
+	void calcCellOrder(const size_t (& div)[dim], size_t tot_n_cell)
+	{
+		cell_mem.clear();
+
+		if (cl_order == CL_CELL_ORDER_LINEAR || tot_n_cell == 0)
+		{return;}
+
+		grid_sm<dim,void> g(div);
+		std::vector<std::pair<size_t,size_t>> zk(tot_n_cell);
+
+		// order of the Hilbert curve that cover the grid
+
+		size_t m = 0;
+		for (size_t d = 0 ; d < dim ; d++)
+		{
+			while (((size_t)1 << m) < div[d])	{m++;}
+		}
+
+		#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(tot_n_cell)) schedule(static)
+		for (size_t i = 0 ; i < tot_n_cell ; i++)
+		{
+			if (cl_order == CL_CELL_ORDER_HILBERT)
+			{zk[i].first = lin_hid(g.InvLinId(i),m);}
+			else
+			{zk[i].first = cl_morton_key<dim>::get(g.InvLinId(i));}
+			zk[i].second = i;
+		}
+
+		std::sort(zk.begin(),zk.end());
+
+		cell_mem.resize(tot_n_cell);
+
+		#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(tot_n_cell)) schedule(static)
+		for (size_t i = 0 ; i < tot_n_cell ; i++)
+		{cell_mem.get(zk[i].second) = i;}
+	}
+
+	/*! \brief Calculate the cell of every particle
+	 *
+	 * \param pos vector of positions
+	 * \param g_m marker
+	 * \param opt CL_NON_SYMMETRIC or CL_SYMMETRIC
+	 * \param cells position in memory of the cell of each particle (output)
+	 *
+	 */
+	template<typename vector_pos>
+	void calcCells(const vector_pos & pos, size_t g_m, size_t opt, typename Mem_type::local_index_type * cells)
+	{
+		size_t n = pos.size();
+
+		// with the symmetric option the domain particles use getCellDom, the others
+		// are converted in blocks with getCellBatch
+		size_t n_dom = (opt == CL_SYMMETRIC)?std::min(g_m,n):0;
+
+		#pragma omp parallel num_threads(openfpm::cpu_num_threads_for(n))
+		{
+			size_t start;
+			size_t stop;
+			openfpm::cpu_chunk(n,openfpm::cpu_team_size(),openfpm::cpu_thread_id(),start,stop);
+
+			size_t i = start;
+			for ( ; i < stop && i < n_dom ; i++)
+			{
+				Point<dim,T> p = pos.get(i);
+				cells[i] = this->getCellDom(p);
+			}
+
+			if (i < stop)
+			{this->getCellBatch(pos,i,stop,&cells[i]);}
+
+			if (cl_order != CL_CELL_ORDER_LINEAR)
+			{
+				for (size_t j = start ; j < stop ; j++)
+				{cells[j] = cell_mem.get(cells[j]);}
+			}
+		}
+	}
+
 
 
 	//! Initialize the structures of the data structure
@@ -395,6 +594,10 @@ private:
 	{
 		Mem_type::init_to_zero(slot,tot_n_cell);
 
+		calcCellOrder(div,tot_n_cell);
+		calcPeriodicShift();
+		part_cell.clear();
+
 		NNc_full.set_size(div);
 		NNc_full.init_full();
 
@@ -423,12 +626,226 @@ private:
 		cd.setDimensions(cd_sm.getDomain(),div_big,div, pad, bx.getP1());
 	}
 
+	/*! \brief Search the k nearest neighbors of a point
+	 *
+	 * The cells are visited in shells of increasing Chebyshev distance from the cell of the
+	 * point, the k closest particles are kept in a bounded max-heap. After the shell s every
+	 * cell not visited is at least at distance s*spacing, when the k-th distance is smaller
+	 * the search stop
+	 *
+	 * \param xp point
+	 * \param k number of neighbors
+	 * \param pos positions of the particles
+	 * \param heap (squared distance, particle) of the neighbors sorted by increasing distance (output)
+	 *
+	 */
+	template<typename vector_pos>
+	void knn_search(const Point<dim,T> & xp, size_t k, const vector_pos & pos,
+			        std::vector<std::pair<T,typename Mem_type::local_index_type>> & heap) const
+	{
+		typedef std::pair<T,typename Mem_type::local_index_type> nn_type;
+
+		heap.clear();
+		if (k == 0)	{return;}
+
+		const grid_sm<dim,void> & gr = this->getInternalGrid();
+		grid_key_dx<dim> g = this->getCellGrid(xp);
+
+		long int gc[dim];
+		long int sz[dim];
+		long int s_max = 0;
+		T sp = std::numeric_limits<T>::max();
+
+		for (size_t d = 0 ; d < dim ; d++)
+		{
+			sz[d] = gr.size(d);
+			gc[d] = g.get(d);
+			gc[d] = (gc[d] < 0)?0:((gc[d] >= sz[d])?sz[d]-1:gc[d]);
+
+			s_max = std::max(s_max,std::max(gc[d],sz[d]-1-gc[d]));
+			sp = std::min(sp,this->getCellBox().getHigh(d));
+		}
+
+		auto visit = [&](grid_key_dx<dim> & key)
+		{
+			size_t c = cellMem(gr.LinId(key));
+
+			for (size_t j = 0 ; j < Mem_type::getNelements(c) ; j++)
+			{
+				auto q = Mem_type::get(c,j);
+				Point<dim,T> xq = pos.get(q);
+				nn_type nn(xp.distance2(xq),q);
+
+				if (heap.size() < k)
+				{
+					heap.push_back(nn);
+					std::push_heap(heap.begin(),heap.end());
+				}
+				else if (nn < heap.front())
+				{
+					std::pop_heap(heap.begin(),heap.end());
+					heap.back() = nn;
+					std::push_heap(heap.begin(),heap.end());
+				}
+			}
+		};
+
+		for (long int s = 0 ; s <= s_max ; s++)
+		{
+			long int lo[dim];
+			long int hi[dim];
+
+			for (size_t d = 0 ; d < dim ; d++)
+			{
+				lo[d] = std::max(gc[d] - s,0l);
+				hi[d] = std::min(gc[d] + s,sz[d]-1);
+			}
+
+			// iterate over the first dim-1 coordinates of the block, along the last
+			// coordinate the full range is visited only on the faces of the shell
+
+			grid_key_dx<dim> key;
+			for (size_t d = 0 ; d < dim - 1 ; d++)
+			{key.set_d(d,lo[d]);}
+
+			while (true)
+			{
+				bool on_shell = false;
+				for (size_t d = 0 ; d < dim - 1 ; d++)
+				{on_shell |= (std::abs(key.get(d) - gc[d]) == s);}
+
+				if (on_shell == true)
+				{
+					for (long int z = lo[dim-1] ; z <= hi[dim-1] ; z++)
+					{
+						key.set_d(dim-1,z);
+						visit(key);
+					}
+				}
+				else
+				{
+					if (gc[dim-1] - s >= 0)
+					{
+						key.set_d(dim-1,gc[dim-1] - s);
+						visit(key);
+					}
+
+					if (s != 0 && gc[dim-1] + s < sz[dim-1])
+					{
+						key.set_d(dim-1,gc[dim-1] + s);
+						visit(key);
+					}
+				}
+
+				// next
+
+				size_t d = 0;
+				for ( ; d < dim - 1 ; d++)
+				{
+					if (key.get(d) < hi[d])
+					{
+						key.set_d(d,key.get(d)+1);
+						break;
+					}
+
+					key.set_d(d,lo[d]);
+				}
+
+				if (d == dim - 1)	{break;}
+			}
+
+			T bound = s*sp;
+			if (heap.size() == k && heap.front().first < bound*bound)	{break;}
+		}
+
+		std::sort_heap(heap.begin(),heap.end());
+	}
+
+	/*! \brief Visit the particles closer than r to a point
+	 *
+	 * The cells of the block of half-width ceil(r/spacing) around the cell of the point are
+	 * visited, the cells that are surely farther than r are skipped
+	 *
+	 * \param xp point
+	 * \param r2 square of the radius
+	 * \param w half-width of the block in cells
+	 * \param pos positions of the particles
+	 * \param f functor called with the id of every particle closer than r
+	 *
+	 */
+	template<typename vector_pos, typename functor>
+	void range_search(const Point<dim,T> & xp, T r2, const long int (& w)[dim], const vector_pos & pos, functor f) const
+	{
+		const grid_sm<dim,void> & gr = this->getInternalGrid();
+		grid_key_dx<dim> g = this->getCellGrid(xp);
+
+		long int lo[dim];
+		long int hi[dim];
+
+		for (size_t d = 0 ; d < dim ; d++)
+		{
+			long int sz = gr.size(d);
+			long int gc = g.get(d);
+			gc = (gc < 0)?0:((gc >= sz)?sz-1:gc);
+
+			g.set_d(d,gc);
+			lo[d] = std::max(gc - w[d],0l);
+			hi[d] = std::min(gc + w[d],sz-1);
+		}
+
+		grid_key_dx<dim> key;
+		for (size_t d = 0 ; d < dim ; d++)
+		{key.set_d(d,lo[d]);}
+
+		while (true)
+		{
+			// lower bound of the distance between the point and the cell
+
+			T dc = 0;
+			for (size_t d = 0 ; d < dim ; d++)
+			{
+				long int dd = std::abs(key.get(d) - g.get(d)) - 1;
+				T l = (dd > 0)?dd*this->getCellBox().getHigh(d):0;
+				dc += l*l;
+			}
+
+			if (dc < r2)
+			{
+				size_t c = cellMem(gr.LinId(key));
+
+				for (size_t j = 0 ; j < Mem_type::getNelements(c) ; j++)
+				{
+					auto q = Mem_type::get(c,j);
+					Point<dim,T> xq = pos.get(q);
+
+					if (xp.distance2(xq) < r2)	{f(q);}
+				}
+			}
+
+			// next
+
+			size_t d = 0;
+			for ( ; d < dim ; d++)
+			{
+				if (key.get(d) < hi[d])
+				{
+					key.set_d(d,key.get(d)+1);
+					break;
+				}
+
+				key.set_d(d,lo[d]);
+			}
+
+			if (d == dim)	{break;}
+		}
+	}
+
 public:
 
 	//! Type of internal memory structure
 	typedef Mem_type Mem_type_type;
 
-	typedef CellNNIteratorSym<dim,CellList<dim,T,Mem_type,transform,vector_pos_type>,vector_pos_type,RUNTIME,NO_CHECK> SymNNIterator;
+	typedef CellNNIteratorSym<dim,CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order>,vector_pos_type,RUNTIME,NO_CHECK> SymNNIterator;
 
 	//! Object type that the structure store
 	typedef typename Mem_type::local_index_type value_type;
@@ -436,6 +853,9 @@ public:
 	//! Type of the coordinate space (double float)
 	typedef T stype;
 
+	//! dimensionality of the space
+	static const unsigned int dims = dim;
+
 	//!
 	typedef vector_pos_type internal_vector_pos_type;
 
@@ -533,14 +953,14 @@ public:
 	{};
 
 	//! Copy constructor
-	CellList(const CellList<dim,T,Mem_type,transform,vector_pos_type> & cell)
+	CellList(const CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order> & cell)
 	:Mem_type(STARTING_NSLOT)
 	{
 		this->operator=(cell);
 	}
 
 	//! Copy constructor
-	CellList(CellList<dim,T,Mem_type,transform,vector_pos_type> && cell)
+	CellList(CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order> && cell)
 	:Mem_type(STARTING_NSLOT)
 	{
 		this->operator=(cell);
@@ -622,7 +1042,7 @@ public:
 	 * \return itself
 	 *
 	 */
-	CellList<dim,T,Mem_type,transform> & operator=(CellList<dim,T,Mem_type,transform> && cell)
+	CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order> & operator=(CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order> && cell)
 	{
 		std::copy(&cell.NNc_full[0],&cell.NNc_full[openfpm::math::pow(3,dim)],&NNc_full[0]);
 		std::copy(&cell.NNc_sym[0],&cell.NNc_sym[openfpm::math::pow(3,dim)/2+1],&NNc_sym[0]);
@@ -634,6 +1054,15 @@ public:
 		n_dec = cell.n_dec;
 		from_cd = cell.from_cd;
 
+		part_cell.swap(cell.part_cell);
+		fill_g_m = cell.fill_g_m;
+		fill_opt = cell.fill_opt;
+
+		cell_mem.swap(cell.cell_mem);
+
+		std::copy(cell.bc,cell.bc+dim,bc);
+		std::copy(cell.p_shift,cell.p_shift+openfpm::math::pow(3,dim),p_shift);
+
 		return *this;
 	}
 
@@ -644,7 +1073,7 @@ public:
 	 * \return itself
 	 *
 	 */
-	CellList<dim,T,Mem_type,transform,vector_pos_type> & operator=(const CellList<dim,T,Mem_type,transform,vector_pos_type> & cell)
+	CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order> & operator=(const CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order> & cell)
 	{
 		NNc_full = cell.NNc_full;
 		NNc_sym = cell.NNc_sym;
@@ -656,6 +1085,15 @@ public:
 		n_dec = cell.n_dec;
 		from_cd = cell.from_cd;
 
+		part_cell = cell.part_cell;
+		fill_g_m = cell.fill_g_m;
+		fill_opt = cell.fill_opt;
+
+		cell_mem = cell.cell_mem;
+
+		std::copy(cell.bc,cell.bc+dim,bc);
+		std::copy(cell.p_shift,cell.p_shift+openfpm::math::pow(3,dim),p_shift);
+
 		return *this;
 	}
 
@@ -667,7 +1105,7 @@ public:
 	 *
 	 */
 	template<typename Mem_type2>
-	CellList<dim,T,Mem_type,transform,vector_pos_type> & operator=(const CellList<dim,T,Mem_type2,transform,vector_pos_type> & cell)
+	CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order> & operator=(const CellList<dim,T,Mem_type2,transform,vector_pos_type,cl_order> & cell)
 	{
 		NNc_full = cell.private_get_NNc_full();
 		NNc_sym = cell.private_get_NNc_sym();
@@ -679,6 +1117,18 @@ public:
 		n_dec = cell.get_ndec();
 		from_cd = cell.private_get_from_cd();
 
+		// the memory structure is copied as it is, the cells are in the same order
+
+		size_t div[dim];
+		for (size_t d = 0 ; d < dim ; d++)
+		{div[d] = this->getInternalGrid().size(d);}
+
+		calcCellOrder(div,getNCells());
+
+		for (size_t d = 0 ; d < dim ; d++)
+		{bc[d] = cell.getBC(d);}
+		calcPeriodicShift();
+
 		return *this;
 	}
 
@@ -714,7 +1164,19 @@ public:
 	 */
 	inline void addCell(size_t cell_id, typename Mem_type::local_index_type ele)
 	{
-		Mem_type::addCell(cell_id,ele);
+		Mem_type::addCell(cellMem(cell_id),ele);
+	}
+
+	/*! \brief Complete a batch of add()
+	 *
+	 * Memory types that buffer the added elements (Mem_compact) insert them here, for
+	 * the other it does nothing. It must be called after add() and before reading
+	 * the cell-list, fill() and update() call it already
+	 *
+	 */
+	inline void finalize()
+	{
+		Mem_type::finalize();
 	}
 
 	/*! \brief Add an element in the cell list
@@ -728,7 +1190,7 @@ public:
 		// calculate the Cell id
 		size_t cell_id = this->getCell(pos);
 
-		Mem_type::add(cell_id,ele);
+		Mem_type::add(cellMem(cell_id),ele);
 	}
 
 	/*! \brief Add an element in the cell list
@@ -742,7 +1204,7 @@ public:
 		// calculate the Cell id
 		size_t cell_id = this->getCell(pos);
 
-		Mem_type::add(cell_id,ele);
+		Mem_type::add(cellMem(cell_id),ele);
 	}
 
 
@@ -822,6 +1284,334 @@ public:
 		addCell(cell_id,ele);
 	}
 
+	/*! \brief Fill the cell list with all the particles in one shot
+	 *
+	 * The result is identical to clear() followed by add(pos.get(i),i) for every particle
+	 * (addDom() below the marker g_m and addPad() above in the symmetric case). The cell of
+	 * each particle is calculated in parallel and the particles are bucketed with a parallel
+	 * histogram, prefix sum and scatter
+	 *
+	 * \param pos vector of positions
+	 * \param g_m marker (particle below this marker must be inside the domain, particles outside this marker must be outside the domain)
+	 * \param opt CL_NON_SYMMETRIC or CL_SYMMETRIC
+	 *
+	 */
+	template<typename vector_pos>
+	void fill(const vector_pos & pos, size_t g_m, size_t opt = CL_NON_SYMMETRIC)
+	{
+		size_t n = pos.size();
+
+		part_cell.resize(n);
+		fill_g_m = g_m;
+		fill_opt = opt;
+
+		if (n == 0)
+		{
+			Mem_type::clear();
+			return;
+		}
+
+		calcCells(pos,g_m,opt,&part_cell.get(0));
+
+		Mem_type::fill(&part_cell.get(0),n);
+	}
+
+	/*! \brief Update the cell list after the particles moved
+	 *
+	 * The cell list must have been filled with fill(). Only the particles that changed cell
+	 * are moved: the new cell of every particle is calculated in parallel, the particles
+	 * leaving a cell are removed from it in one compaction pass per cell, and they are
+	 * appended to their new cell. The marker and the option are the one of the last fill().
+	 * If the number of particles changed the cell list is filled again.
+	 *
+	 * The content of every cell is the same as after fill(), the order of the elements
+	 * inside a cell can differ (the particles that arrive are appended)
+	 *
+	 * \note with Mem_compact removing an element is O(N), the structure is reconstructed
+	 *       in one pass from the new cells (the order is the one of fill())
+	 *
+	 * \param pos vector of positions
+	 *
+	 * \return the number of particles that changed cell
+	 *
+	 */
+	template<typename vector_pos>
+	size_t update(const vector_pos & pos)
+	{
+		typedef typename Mem_type::local_index_type local_index;
+
+		size_t n = pos.size();
+
+		if (n != part_cell.size())
+		{
+			fill(pos,std::min(fill_g_m,n),fill_opt);
+			return n;
+		}
+
+		openfpm::vector<local_index> cells(n);
+		if (n != 0)
+		{calcCells(pos,fill_g_m,fill_opt,&cells.get(0));}
+
+		// collect the particles that changed cell, every thread collect a contiguous
+		// range so that the concatenation is in particle order
+
+		size_t nth = openfpm::cpu_num_threads_for(n);
+		openfpm::vector<openfpm::vector<local_index>> mv_th(nth);
+
+		#pragma omp parallel num_threads(nth)
+		{
+			int t = openfpm::cpu_thread_id();
+
+			size_t start;
+			size_t stop;
+			openfpm::cpu_chunk(n,openfpm::cpu_team_size(),t,start,stop);
+
+			for (size_t i = start ; i < stop ; i++)
+			{
+				if (cells.get(i) != part_cell.get(i))
+				{mv_th.get(t).add(i);}
+			}
+		}
+
+		openfpm::vector<local_index> movers;
+		for (size_t t = 0 ; t < nth ; t++)
+		{
+			for (size_t j = 0 ; j < mv_th.get(t).size() ; j++)
+			{movers.add(mv_th.get(t).get(j));}
+		}
+
+		if (movers.size() == 0)	{return 0;}
+
+		if (is_mem_compact<Mem_type>::value == true)
+		{
+			Mem_type::fill(&cells.get(0),n);
+			part_cell.swap(cells);
+
+			return movers.size();
+		}
+
+		// cells that lose particles, each one is compacted once
+
+		openfpm::vector<local_index> old_cells(movers.size());
+		for (size_t j = 0 ; j < movers.size() ; j++)
+		{old_cells.get(j) = part_cell.get(movers.get(j));}
+
+		std::sort(old_cells.begin(),old_cells.end());
+
+		for (size_t j = 0 ; j < old_cells.size() ; j++)
+		{
+			local_index c = old_cells.get(j);
+			if (j != 0 && old_cells.get(j-1) == c)	{continue;}
+
+			size_t n_ele = Mem_type::getNelements(c);
+			size_t k = 0;
+
+			for (size_t e = 0 ; e < n_ele ; e++)
+			{
+				local_index p = Mem_type::get(c,e);
+				if (cells.get(p) == c)
+				{
+					Mem_type::get(c,k) = p;
+					k++;
+				}
+			}
+
+			for (size_t e = n_ele ; e > k ; e--)
+			{Mem_type::remove(c,e-1);}
+		}
+
+		// append the particles to their new cell
+
+		for (size_t j = 0 ; j < movers.size() ; j++)
+		{
+			local_index p = movers.get(j);
+			Mem_type::addCell(cells.get(p),p);
+		}
+
+		Mem_type::finalize();
+
+		part_cell.swap(cells);
+
+		return movers.size();
+	}
+
+	/*! \brief Find the k nearest neighbors of a point
+	 *
+	 * The point does not need to be a particle of the cell-list, but it must be inside the
+	 * space covered by the cells (padding included). If the point is a particle it is
+	 * returned as the first neighbor (distance zero)
+	 *
+	 * \param xp point
+	 * \param k number of neighbors
+	 * \param pos positions of the particles stored in the cell-list
+	 * \param out particle (property 0) and squared distance (property 1) of the neighbors
+	 *        sorted by increasing distance. It contain less than k elements only if the
+	 *        cell-list contain less than k particles
+	 *
+	 */
+	template<typename vector_pos>
+	void knn(const Point<dim,T> & xp, size_t k, const vector_pos & pos,
+			 openfpm::vector<aggregate<typename Mem_type::local_index_type,T>> & out) const
+	{
+		std::vector<std::pair<T,typename Mem_type::local_index_type>> heap;
+
+		knn_search(xp,k,pos,heap);
+
+		out.resize(heap.size());
+		for (size_t i = 0 ; i < heap.size() ; i++)
+		{
+			out.template get<0>(i) = heap[i].second;
+			out.template get<1>(i) = heap[i].first;
+		}
+	}
+
+	/*! \brief Find the k nearest neighbors of a set of points in parallel
+	 *
+	 * \see knn
+	 *
+	 * \param queries points
+	 * \param k number of neighbors
+	 * \param pos positions of the particles stored in the cell-list
+	 * \param out particle (property 0) and squared distance (property 1) of the neighbors,
+	 *        the neighbors of the query i are in [i*kk,(i+1)*kk) sorted by increasing distance
+	 *
+	 * \return kk the number of neighbors for each query, min(k, number of particles)
+	 *
+	 */
+	template<typename vector_q, typename vector_pos>
+	size_t knnBatch(const vector_q & queries, size_t k, const vector_pos & pos,
+			        openfpm::vector<aggregate<typename Mem_type::local_index_type,T>> & out) const
+	{
+		size_t n_q = queries.size();
+
+		// this also construct the lazily constructed memory types before
+		// reading them concurrently
+
+		size_t n_part = 0;
+		for (size_t c = 0 ; c < getNCells() ; c++)
+		{n_part += Mem_type::getNelements(c);}
+
+		size_t kk = std::min(k,n_part);
+
+		out.resize(n_q*kk);
+
+		#pragma omp parallel num_threads(openfpm::cpu_num_threads_for(n_q*64))
+		{
+			std::vector<std::pair<T,typename Mem_type::local_index_type>> heap;
+
+			#pragma omp for schedule(dynamic,64)
+			for (size_t i = 0 ; i < n_q ; i++)
+			{
+				Point<dim,T> xp = queries.get(i);
+
+				knn_search(xp,kk,pos,heap);
+
+				for (size_t j = 0 ; j < kk ; j++)
+				{
+					out.template get<0>(i*kk+j) = heap[j].second;
+					out.template get<1>(i*kk+j) = heap[j].first;
+				}
+			}
+		}
+
+		return kk;
+	}
+
+	/*! \brief Find the particles closer than r to every point of a set (range query)
+	 *
+	 * The points does not need to be particles of the cell-list, but they must be inside the
+	 * space covered by the cells (padding included). The radius can be bigger than the cells.
+	 * The queries are bucketed by cell so that consecutive queries read the same cells, and
+	 * processed in parallel. The result is in CSR format, two passes are done: the first
+	 * count the neighbors of every query, the second fill the result
+	 *
+	 * \param queries points
+	 * \param r radius
+	 * \param pos positions of the particles stored in the cell-list
+	 * \param start start of the neighbors of every query in ids (queries.size()+1 elements)
+	 * \param ids neighbors, the neighbors of the query i are ids[start[i]] ... ids[start[i+1]-1]
+	 *
+	 */
+	template<typename vector_q, typename vector_pos>
+	void rangeQueryBatch(const vector_q & queries, T r, const vector_pos & pos,
+			             openfpm::vector<aggregate<typename Mem_type::local_index_type>> & start,
+			             openfpm::vector<aggregate<typename Mem_type::local_index_type>> & ids) const
+	{
+		typedef typename Mem_type::local_index_type local_index;
+
+		size_t n_q = queries.size();
+		size_t n_cell = getNCells();
+
+		start.resize(n_q+1);
+
+		if (n_q == 0)
+		{
+			start.template get<0>(0) = 0;
+			ids.clear();
+			return;
+		}
+
+		long int w[dim];
+		for (size_t d = 0 ; d < dim ; d++)
+		{w[d] = std::ceil(r / this->getCellBox().getHigh(d));}
+
+		// bucket the queries by cell
+
+		std::vector<local_index> q_cell(n_q);
+		std::vector<local_index> q_ord(n_q);
+		std::vector<local_index> q_start(n_cell+1);
+
+		#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(n_q)) schedule(static)
+		for (size_t i = 0 ; i < n_q ; i++)
+		{
+			Point<dim,T> xp = queries.get(i);
+			grid_key_dx<dim> key = this->getCellGrid(xp);
+
+			for (size_t d = 0 ; d < dim ; d++)
+			{
+				long int sz = this->getInternalGrid().size(d);
+				key.set_d(d,(key.get(d) < 0)?0:((key.get(d) >= sz)?sz-1:key.get(d)));
+			}
+
+			q_cell[i] = this->getInternalGrid().LinId(key);
+		}
+
+		openfpm::cpu_bucket_sort(q_cell.data(),n_q,n_cell,q_ord.data(),q_start.data());
+
+		// count and fill
+
+		T r2 = r*r;
+
+		for (size_t pass = 0 ; pass < 2 ; pass++)
+		{
+			#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(n_q*64)) schedule(dynamic,64)
+			for (size_t i = 0 ; i < n_q ; i++)
+			{
+				size_t q = q_ord[i];
+				Point<dim,T> xp = queries.get(q);
+
+				if (pass == 0)
+				{
+					size_t cnt = 0;
+					range_search(xp,r2,w,pos,[&cnt](local_index p){cnt++;});
+					start.template get<0>(q) = cnt;
+				}
+				else
+				{
+					size_t k = start.template get<0>(q);
+					range_search(xp,r2,w,pos,[&k,&ids](local_index p){ids.template get<0>(k) = p; k++;});
+				}
+			}
+
+			if (pass == 0)
+			{
+				start.template get<0>(n_q) = 0;
+				openfpm::cpu_scan(&start.template get<0>(0),n_q+1,&start.template get<0>(0));
+				ids.resize(start.template get<0>(n_q));
+			}
+		}
+	}
+
 	/*! \brief remove an element from the cell
 	 *
 	 * \param cell cell id
@@ -830,7 +1620,7 @@ public:
 	 */
 	inline void remove(size_t cell, size_t ele)
 	{
-		Mem_type::remove(cell,ele);
+		Mem_type::remove(cellMem(cell),ele);
 	}
 
 	/*! \brief Get the number of cells this cell-list contain
@@ -851,7 +1641,7 @@ public:
 	 */
 	inline size_t getNelements(const size_t cell_id) const
 	{
-		return Mem_type::getNelements(cell_id);
+		return Mem_type::getNelements(cellMem(cell_id));
 	}
 
 	/*! \brief Get an element in the cell
@@ -866,7 +1656,7 @@ public:
 	 */
 	inline auto get(size_t cell, size_t ele) -> decltype(this->Mem_type::get(cell,ele))
 	{
-		return Mem_type::get(cell,ele);
+		return Mem_type::get(cellMem(cell),ele);
 	}
 
 	/*! \brief Get an element in the cell
@@ -881,7 +1671,17 @@ public:
 	 */
 	inline auto get(size_t cell, size_t ele) const -> decltype(this->Mem_type::get(cell,ele))
 	{
-		return Mem_type::get(cell,ele);
+		return Mem_type::get(cellMem(cell),ele);
+	}
+
+	/*! \brief Return the order in which the cells are stored in memory
+	 *
+	 * \return CL_CELL_ORDER_LINEAR, CL_CELL_ORDER_MORTON or CL_CELL_ORDER_HILBERT
+	 *
+	 */
+	size_t getCellOrder() const
+	{
+		return cl_order;
 	}
 
 	/*! \brief Swap the memory
@@ -889,7 +1689,7 @@ public:
 	 * \param cl Cell list with witch you swap the memory
 	 *
 	 */
-	inline void swap(CellList<dim,T,Mem_type,transform,vector_pos_type> & cl)
+	inline void swap(CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order> & cl)
 	{
 		NNc_full.swap(cl.NNc_full);
 		NNc_sym.swap(cl.NNc_sym);
@@ -900,6 +1700,15 @@ public:
 
 		n_dec = cl.n_dec;
 		from_cd = cl.from_cd;
+
+		part_cell.swap(cl.part_cell);
+		std::swap(fill_g_m,cl.fill_g_m);
+		std::swap(fill_opt,cl.fill_opt);
+
+		cell_mem.swap(cl.cell_mem);
+
+		std::swap_ranges(bc,bc+dim,cl.bc);
+		std::swap_ranges(p_shift,p_shift+openfpm::math::pow(3,dim),cl.p_shift);
 	}
 
 	/*! \brief Get the Cell iterator
@@ -909,9 +1718,9 @@ public:
 	 * \return the iterator to the elements inside cell
 	 *
 	 */
-	CellIterator<CellList<dim,T,Mem_type,transform>> getCellIterator(size_t cell)
+	CellIterator<CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order>> getCellIterator(size_t cell)
 	{
-		return CellIterator<CellList<dim,T,Mem_type,transform>>(cell,*this);
+		return CellIterator<CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order>>(cell,*this);
 	}
 
 	/*! \brief Get the Neighborhood iterator
@@ -934,9 +1743,9 @@ public:
 	 * \return An iterator across the neighhood particles
 	 *
 	 */
-	template<unsigned int impl=NO_CHECK> inline CellNNIteratorRadius<dim,CellList<dim,T,Mem_type,transform>,impl> getNNIteratorRadius(size_t cell)
+	template<unsigned int impl=NO_CHECK> inline CellNNIteratorRadius<dim,CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order>,impl> getNNIteratorRadius(size_t cell)
 	{
-		CellNNIteratorRadius<dim,CellList<dim,T,Mem_type,transform>,impl> cln(cell,nnc_rad,*this);
+		CellNNIteratorRadius<dim,CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order>,impl> cln(cell,nnc_rad,*this);
 		return cln;
 	}
 
@@ -961,17 +1770,101 @@ public:
 	 *
 	 */
 	template<unsigned int impl=NO_CHECK>
-	__attribute__((always_inline)) inline CellNNIterator<dim,CellList<dim,T,Mem_type,transform,vector_pos_type>,(int)FULL,impl> getNNIterator(size_t cell)
+	__attribute__((always_inline)) inline CellNNIterator<dim,CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order>,(int)FULL,impl> getNNIterator(size_t cell)
+	{
+		CellNNIterator<dim,CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order>,(int)FULL,impl> cln(cell,NNc_full,*this);
+		return cln;
+
+	}
+
+	/*! \brief Set the boundary conditions used by getNNIteratorPeriodic
+	 *
+	 * \param bc boundary conditions PERIODIC or NON_PERIODIC for every dimension
+	 *
+	 */
+	void setPeriodic(const size_t (& bc)[dim])
+	{
+		for (size_t d = 0 ; d < dim ; d++)
+		{this->bc[d] = bc[d];}
+	}
+
+	/*! \brief Return the boundary condition used by getNNIteratorPeriodic
+	 *
+	 * \param d dimension
+	 *
+	 * \return PERIODIC or NON_PERIODIC
+	 *
+	 */
+	size_t getBC(size_t d) const
+	{
+		return bc[d];
+	}
+
+	/*! \brief Return the shift of a periodic image
+	 *
+	 * \param k shift id (see getNNIteratorPeriodic)
+	 *
+	 * \return the shift
+	 *
+	 */
+	inline const Point<dim,T> & getPeriodicShift(size_t k) const
 	{
-		CellNNIterator<dim,CellList<dim,T,Mem_type,transform,vector_pos_type>,(int)FULL,impl> cln(cell,NNc_full,*this);
+		return p_shift[k];
+	}
+
+	/*! \brief Get the periodic Neighborhood iterator
+	 *
+	 * It iterate across all the element of the selected cell and the near cells. On the
+	 * periodic dimensions (setPeriodic) the near cells are wrapped across the domain and
+	 * the iterator return with getShift() the shift to add to the position of the neighborhood
+	 * particle. The Cell-list can be initialized without padding (pad = 0) and filled only
+	 * with the domain particles, no ghost copies are needed
+	 *
+	 * \note the periodic dimensions need at least 3 cells, the cut-off radius must be smaller
+	 *       than the cell spacing. The Cell-list must be defined on the full periodic domain
+	 *       (Initialize(box,div,pad))
+	 *
+	 * \param cell cell id
+	 *
+	 * \return An iterator across the neighborhood particles
+	 *
+	 */
+	inline CellNNIteratorPeriodic<dim,CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order>> getNNIteratorPeriodic(size_t cell)
+	{
+		CellNNIteratorPeriodic<dim,CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order>> cln(cell,*this);
 		return cln;
+	}
 
+	/*! \brief Get the neighborhood cells up to some selected radius
+	 *
+	 * The neighborhood is calculated on the first call with a radius and cached. The call
+	 * modify the cache, to iterate from several threads get the neighborhood once before and
+	 * use getNNIteratorRadius(cell,NNc)
+	 *
+	 * \param r_cut radius
+	 *
+	 * \return the relative ids of the neighborhood cells
+	 *
+	 */
+	const openfpm::vector<long int> & getNNcRadius(T r_cut)
+	{
+		std::unique_ptr<openfpm::vector<long int>> & NNc_ptr = rcache[r_cut];
+
+		if (NNc_ptr == NULL)
+		{
+			NNc_ptr.reset(new openfpm::vector<long int>());
+			NNcalc_rad(r_cut,*NNc_ptr,this->getCellBox(),this->getGrid());
+		}
+
+		return *NNc_ptr;
 	}
 
 	/*! \brief Get the symmetric Neighborhood iterator
 	 *
 	 * It iterate across all the element of the selected cell and the near cells up to some selected radius
 	 *
+	 * \note it can modify the cache of the neighborhoods (see getNNcRadius)
+	 *
 	 * \param cell cell id
 	 * \param r_cut radius
 	 *
@@ -979,14 +1872,25 @@ public:
 	 *
 	 */
 	template<unsigned int impl=NO_CHECK>
-	__attribute__((always_inline)) inline CellNNIteratorRadius<dim,CellList<dim,T,Mem_type,transform,vector_pos_type>,impl> getNNIteratorRadius(size_t cell, T r_cut)
+	__attribute__((always_inline)) inline CellNNIteratorRadius<dim,CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order>,impl> getNNIteratorRadius(size_t cell, T r_cut)
 	{
-		openfpm::vector<long int> & NNc = rcache[r_cut];
-
-		if (NNc.size() == 0)
-		{NNcalc_rad(r_cut,NNc,this->getCellBox(),this->getGrid());}
+		return this->template getNNIteratorRadius<impl>(cell,getNNcRadius(r_cut));
+	}
 
-		CellNNIteratorRadius<dim,CellList<dim,T,Mem_type,transform,vector_pos_type>,impl> cln(cell,NNc,*this);
+	/*! \brief Get the Neighborhood iterator across the neighborhood cells NNc
+	 *
+	 * It does not access the cache of the neighborhoods, it can be called concurrently
+	 *
+	 * \param cell cell id
+	 * \param NNc neighborhood cells obtained with getNNcRadius
+	 *
+	 * \return An iterator across the neighborhood particles
+	 *
+	 */
+	template<unsigned int impl=NO_CHECK>
+	__attribute__((always_inline)) inline CellNNIteratorRadius<dim,CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order>,impl> getNNIteratorRadius(size_t cell, const openfpm::vector<long int> & NNc)
+	{
+		CellNNIteratorRadius<dim,CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order>,impl> cln(cell,NNc,*this);
 
 		return cln;
 	}
@@ -1014,7 +1918,7 @@ public:
 	 *
 	 */
 	template<unsigned int impl>
-	__attribute__((always_inline)) inline CellNNIteratorSym<dim,CellList<dim,T,Mem_type,transform,vector_pos_type>,vector_pos_type,(unsigned int)SYM,impl>
+	__attribute__((always_inline)) inline CellNNIteratorSym<dim,CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order>,vector_pos_type,(unsigned int)SYM,impl>
 	getNNIteratorSym(size_t cell, size_t p, const vector_pos_type & v)
 	{
 #ifdef SE_CLASS1
@@ -1022,7 +1926,7 @@ public:
 		{std::cerr << __FILE__ << ":" << __LINE__ << " Warning when you try to get a symmetric neighborhood iterator, you must construct the Cell-list in a symmetric way" << std::endl;}
 #endif
 
-		CellNNIteratorSym<dim,CellList<dim,T,Mem_type,transform,vector_pos_type>,vector_pos_type,SYM,impl> cln(cell,p,NNc_sym,*this,v);
+		CellNNIteratorSym<dim,CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order>,vector_pos_type,SYM,impl> cln(cell,p,NNc_sym,*this,v);
 		return cln;
 	}
 
@@ -1049,7 +1953,7 @@ public:
 	 *
 	 */
 	template<unsigned int impl, typename vector_pos_type2>
-	__attribute__((always_inline)) inline CellNNIteratorSymMP<dim,CellList<dim,T,Mem_type,transform,vector_pos_type>,vector_pos_type2,(unsigned int)SYM,impl>
+	__attribute__((always_inline)) inline CellNNIteratorSymMP<dim,CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order>,vector_pos_type2,(unsigned int)SYM,impl>
 	getNNIteratorSymMP(size_t cell, size_t p, const vector_pos_type2 & v_p1, const vector_pos_type2 & v_p2)
 	{
 #ifdef SE_CLASS1
@@ -1057,7 +1961,7 @@ public:
 			std::cerr << __FILE__ << ":" << __LINE__ << " Warning when you try to get a symmetric neighborhood iterator, you must construct the Cell-list in a symmetric way" << std::endl;
 #endif
 
-		CellNNIteratorSymMP<dim,CellList<dim,T,Mem_type,transform,vector_pos_type>,vector_pos_type2,SYM,impl> cln(cell,p,NNc_sym,*this,v_p1,v_p2);
+		CellNNIteratorSymMP<dim,CellList<dim,T,Mem_type,transform,vector_pos_type,cl_order>,vector_pos_type2,SYM,impl> cln(cell,p,NNc_sym,*this,v_p1,v_p2);
 		return cln;
 	}
 
@@ -1100,6 +2004,7 @@ public:
 	void clear()
 	{
 		Mem_type::clear();
+		part_cell.clear();
 	}
 
 	/*! \brief Litterary destroy the memory of the cell list, including the retained one
@@ -1119,7 +2024,7 @@ public:
 	 */
 	__attribute__((always_inline)) inline const typename Mem_type::local_index_type & getStartId(typename Mem_type::local_index_type cell_id) const
 	{
-		return Mem_type::getStartId(cell_id);
+		return Mem_type::getStartId(cellMem(cell_id));
 	}
 
 	/*! \brief Return the end point of the cell p
@@ -1131,7 +2036,7 @@ public:
 	 */
 	__attribute__((always_inline)) inline const typename Mem_type::local_index_type & getStopId(typename Mem_type::local_index_type cell_id) const
 	{
-		return Mem_type::getStopId(cell_id);
+		return Mem_type::getStopId(cellMem(cell_id));
 	}
 
 	/*! \brief Return the neighborhood id
@@ -0,0 +1,655 @@
+/*
+ * CellListAdaptive.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_CELLLIST_CELLLISTADAPTIVE_HPP_
+#define OPENFPM_DATA_SRC_NN_CELLLIST_CELLLISTADAPTIVE_HPP_
+
+#include "NN/CellList/CellDecomposer.hpp"
+#include "Vector/map_vector.hpp"
+#include "util/cpu_parallel_util.hpp"
+#include <limits>
+#include <vector>
+
+//! Maximum number of refinement levels of an adaptive Cell-list
+#define ACL_MAX_LEVEL 20
+
+/*! \brief Node of an adaptive Cell-list
+ *
+ * A node is a top level cell or a sub-cell. The particles of a node are
+ * part[start] ... part[stop-1], the children of a refined node are the 2^dim
+ * consecutive nodes starting from child
+ *
+ */
+template<unsigned int dim, typename T>
+struct acl_node
+{
+	//! bounding box of the particles of the node
+	T low[dim];
+
+	//! bounding box of the particles of the node
+	T high[dim];
+
+	//! first child (-1 for a leaf)
+	long int child;
+
+	//! first particle
+	size_t start;
+
+	//! one past the last particle
+	size_t stop;
+};
+
+/*! \brief Iterator across the candidate neighborhood particles of a point in an adaptive Cell-list
+ *
+ * In general you never create it directly but you get it from CellListAdaptive::getNNIterator
+ *
+ * It visit the top level cells intersecting the query box [xp - r, xp + r] and descend the
+ * sub-cells whose particle bounding box is closer than r to xp. The particles of the leaves
+ * reached are returned, independently from the level of the leaf
+ *
+ * \tparam CellListAdaptive_type type of the adaptive Cell-list
+ *
+ */
+template<typename CellListAdaptive_type>
+class CellListAdaptiveNNIterator
+{
+	//! dimensionality
+	static const unsigned int dim = CellListAdaptive_type::dims;
+
+	//! type of space
+	typedef typename CellListAdaptive_type::stype T;
+
+	//! adaptive Cell-list
+	const CellListAdaptive_type & cl;
+
+	//! query point
+	T xp[dim];
+
+	//! square of the query radius
+	T r2;
+
+	//! top level cells to visit
+	grid_key_dx<dim> start_c;
+
+	//! top level cells to visit
+	grid_key_dx<dim> stop_c;
+
+	//! actual top level cell
+	grid_key_dx<dim> act_c;
+
+	//! true when all the top level cells has been visited
+	bool top_end = false;
+
+	//! nodes to visit
+	size_t stack[ACL_MAX_LEVEL * ((1 << dim) - 1) + 1];
+
+	//! number of nodes in the stack
+	size_t n_stack = 0;
+
+	//! actual particle
+	size_t p_id = 0;
+
+	//! end of the particles of the actual leaf
+	size_t p_stop = 0;
+
+	/*! \brief Square distance of the query point from the bounding box of a node
+	 *
+	 * \param n node
+	 *
+	 * \return the square distance (0 if the point is inside)
+	 *
+	 */
+	inline T distance2(const acl_node<dim,T> & n) const
+	{
+		T d2 = 0;
+
+		for (size_t d = 0 ; d < dim ; d++)
+		{
+			T dl = n.low[d] - xp[d];
+			T dh = xp[d] - n.high[d];
+			T dx = (dl > 0)?dl:((dh > 0)?dh:0);
+			d2 += dx*dx;
+		}
+
+		return d2;
+	}
+
+	//! Go to the next top level cell
+	inline void nextTop()
+	{
+		size_t d = 0;
+		for ( ; d < dim ; d++)
+		{
+			if (act_c.get(d) < stop_c.get(d))
+			{
+				act_c.set_d(d,act_c.get(d)+1);
+				break;
+			}
+
+			act_c.set_d(d,start_c.get(d));
+		}
+
+		if (d == dim)	{top_end = true;}
+	}
+
+	//! Select the next leaf with particles
+	inline void selectValid()
+	{
+		while (p_id == p_stop)
+		{
+			if (n_stack == 0)
+			{
+				if (top_end == true)	{return;}
+
+				stack[n_stack] = cl.getTopGrid().LinId(act_c);
+				n_stack++;
+
+				nextTop();
+			}
+
+			n_stack--;
+			const acl_node<dim,T> & n = cl.getNode(stack[n_stack]);
+
+			if (n.start == n.stop || distance2(n) > r2)	{continue;}
+
+			if (n.child == -1)
+			{
+				p_id = n.start;
+				p_stop = n.stop;
+			}
+			else
+			{
+				for (size_t c = 0 ; c < (1 << dim) ; c++)
+				{
+					stack[n_stack] = n.child + c;
+					n_stack++;
+				}
+			}
+		}
+	}
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param xp query point
+	 * \param r radius
+	 * \param cl adaptive Cell-list
+	 *
+	 */
+	CellListAdaptiveNNIterator(const Point<dim,T> & xp, T r, const CellListAdaptive_type & cl)
+	:cl(cl),r2(r*r)
+	{
+		const grid_sm<dim,void> & gr = cl.getTopGrid();
+		const Box<dim,T> & dom = cl.getDomain();
+		const Box<dim,T> & cb = cl.getCellBox();
+
+		for (size_t d = 0 ; d < dim ; d++)
+		{
+			this->xp[d] = xp.get(d);
+
+			long int lo = std::floor((xp.get(d) - r - dom.getLow(d)) / cb.getHigh(d));
+			long int hi = std::floor((xp.get(d) + r - dom.getLow(d)) / cb.getHigh(d));
+
+			lo = (lo < 0)?0:lo;
+			hi = (hi >= (long int)gr.size(d))?gr.size(d)-1:hi;
+
+			// the query box does not intersect the domain
+			if (lo > hi)	{top_end = true;}
+
+			start_c.set_d(d,lo);
+			stop_c.set_d(d,hi);
+		}
+
+		act_c = start_c;
+
+		if (cl.getNNodes() == 0)	{top_end = true;}
+
+		selectValid();
+	}
+
+	/*! \brief Check if there is the next element
+	 *
+	 * \return true if there is the next element
+	 *
+	 */
+	inline bool isNext() const
+	{
+		return p_id != p_stop;
+	}
+
+	/*! \brief take the next element
+	 *
+	 * \return itself
+	 *
+	 */
+	inline CellListAdaptiveNNIterator & operator++()
+	{
+		p_id++;
+
+		selectValid();
+
+		return *this;
+	}
+
+	/*! \brief Get the actual particle
+	 *
+	 * \return the particle id
+	 *
+	 */
+	inline size_t get() const
+	{
+		return cl.getPart(p_id);
+	}
+};
+
+/*! \brief Adaptive Cell-list for strongly varying particle density
+ *
+ * The domain is decomposed in uniform top level cells (CellDecomposer_sm). The cells
+ * with more than max_part particles are recursively split into 2^dim sub-cells (octree in 3D)
+ * up to max_level levels. Clustered systems do not produce overfilled cells, and the
+ * neighborhood search stay near linear. The neighborhood iterator (getNNIterator) return
+ * the particles of all the leaves, at any level, closer than r to a point, the distance
+ * has to be checked by the user as with the other Cell-lists
+ *
+ * \tparam dim dimensionality
+ * \tparam T type of space
+ *
+ * ### Example
+ *
+ * \code
+ * CellListAdaptive<3,double> cl;
+ * cl.Initialize(box,div,16);
+ * cl.fill(pos,pos.size());
+ *
+ * auto NN = cl.getNNIterator(xp,r_cut);
+ * while (NN.isNext())
+ * {
+ *     size_t q = NN.get();
+ *     // ... check the distance from xp
+ *     ++NN;
+ * }
+ * \endcode
+ *
+ */
+template<unsigned int dim, typename T>
+class CellListAdaptive
+{
+	//! top level cells
+	CellDecomposer_sm<dim,T,shift<dim,T>> cd;
+
+	//! nodes, the first ones are the top level cells
+	std::vector<acl_node<dim,T>> nodes;
+
+	//! particles ordered by leaf
+	openfpm::vector<aggregate<size_t>> part;
+
+	//! maximum number of particles in a leaf (if not at the maximum level)
+	size_t max_part = 16;
+
+	//! maximum number of refinement levels
+	size_t max_level = 8;
+
+	//! deepest level reached
+	size_t level = 0;
+
+	/*! \brief Set the bounding box of a node from its particles
+	 *
+	 * \param n node
+	 * \param pos particle positions
+	 *
+	 */
+	template<typename vector_pos_type>
+	void calcBox(acl_node<dim,T> & n, const vector_pos_type & pos)
+	{
+		for (size_t d = 0 ; d < dim ; d++)
+		{
+			n.low[d] = std::numeric_limits<T>::max();
+			n.high[d] = std::numeric_limits<T>::lowest();
+		}
+
+		for (size_t i = n.start ; i < n.stop ; i++)
+		{
+			size_t p = part.template get<0>(i);
+
+			for (size_t d = 0 ; d < dim ; d++)
+			{
+				T x = pos.template get<0>(p)[d];
+				n.low[d] = (x < n.low[d])?x:n.low[d];
+				n.high[d] = (x > n.high[d])?x:n.high[d];
+			}
+		}
+	}
+
+	/*! \brief Split a node recursively
+	 *
+	 * The children are created in the thread-private buffer nb, with indexes local to the buffer
+	 *
+	 * \param n node to split
+	 * \param rg region of the node
+	 * \param lev level of the node
+	 * \param pos particle positions
+	 * \param nb node buffer
+	 * \param tmp temporal buffer for the particles
+	 * \param lev_max deepest level reached (output)
+	 *
+	 */
+	template<typename vector_pos_type>
+	void split(acl_node<dim,T> & n, const Box<dim,T> & rg, size_t lev, const vector_pos_type & pos,
+			   std::vector<acl_node<dim,T>> & nb, std::vector<size_t> & tmp, size_t & lev_max)
+	{
+		lev_max = (lev > lev_max)?lev:lev_max;
+
+		if (n.stop - n.start <= max_part || lev >= max_level)
+		{
+			n.child = -1;
+			return;
+		}
+
+		const size_t n_child = 1 << dim;
+
+		T ct[dim];
+		for (size_t d = 0 ; d < dim ; d++)
+		{ct[d] = (rg.getLow(d) + rg.getHigh(d)) / 2;}
+
+		// bucket the particles by child
+
+		size_t cnt[(1 << dim) + 1] = {};
+		tmp.resize(n.stop - n.start);
+
+		for (size_t i = n.start ; i < n.stop ; i++)
+		{
+			size_t p = part.template get<0>(i);
+
+			size_t c = 0;
+			for (size_t d = 0 ; d < dim ; d++)
+			{c |= (pos.template get<0>(p)[d] >= ct[d])?(1 << d):0;}
+
+			cnt[c+1]++;
+		}
+
+		for (size_t c = 0 ; c < n_child ; c++)
+		{cnt[c+1] += cnt[c];}
+
+		size_t off[1 << dim];
+		for (size_t c = 0 ; c < n_child ; c++)
+		{off[c] = cnt[c];}
+
+		for (size_t i = n.start ; i < n.stop ; i++)
+		{
+			size_t p = part.template get<0>(i);
+
+			size_t c = 0;
+			for (size_t d = 0 ; d < dim ; d++)
+			{c |= (pos.template get<0>(p)[d] >= ct[d])?(1 << d):0;}
+
+			tmp[off[c]] = p;
+			off[c]++;
+		}
+
+		for (size_t i = n.start ; i < n.stop ; i++)
+		{part.template get<0>(i) = tmp[i - n.start];}
+
+		// create and split the children
+
+		size_t ch = nb.size();
+		n.child = ch;
+		nb.resize(ch + n_child);
+
+		for (size_t c = 0 ; c < n_child ; c++)
+		{
+			acl_node<dim,T> cn;
+			cn.start = n.start + cnt[c];
+			cn.stop = n.start + cnt[c+1];
+
+			Box<dim,T> crg;
+			for (size_t d = 0 ; d < dim ; d++)
+			{
+				crg.setLow(d,(c & (1 << d))?ct[d]:rg.getLow(d));
+				crg.setHigh(d,(c & (1 << d))?rg.getHigh(d):ct[d]);
+			}
+
+			calcBox(cn,pos);
+			split(cn,crg,lev+1,pos,nb,tmp,lev_max);
+
+			// nb can be reallocated by split
+			nb[ch + c] = cn;
+		}
+	}
+
+public:
+
+	//! dimensionality
+	static const unsigned int dims = dim;
+
+	//! type of space
+	typedef T stype;
+
+	/*! \brief Initialize the adaptive Cell-list
+	 *
+	 * \param box Domain where this cell list is living
+	 * \param div number of top level cells on each dimension
+	 * \param max_part maximum number of particles in a leaf
+	 * \param max_level maximum number of refinement levels (at most ACL_MAX_LEVEL)
+	 *
+	 */
+	void Initialize(const Box<dim,T> & box, const size_t (&div)[dim], size_t max_part = 16, size_t max_level = 8)
+	{
+		Matrix<dim,T> mat;
+
+		cd.setDimensions(box,div,mat,0);
+
+		this->max_part = (max_part == 0)?1:max_part;
+		this->max_level = (max_level > ACL_MAX_LEVEL)?ACL_MAX_LEVEL:max_level;
+
+		nodes.clear();
+		part.clear();
+		level = 0;
+	}
+
+	/*! \brief Fill the adaptive Cell-list
+	 *
+	 * The particles must be inside the domain. The top level cells are filled with a
+	 * parallel bucket sort, the overfull cells are refined in parallel
+	 *
+	 * \param pos particle positions
+	 * \param n_part number of particles to add (the first n_part)
+	 *
+	 */
+	template<typename vector_pos_type>
+	void fill(const vector_pos_type & pos, size_t n_part)
+	{
+		size_t n_top = cd.getGrid().size();
+
+		part.resize(n_part);
+		nodes.clear();
+		level = 0;
+
+		if (n_part == 0)
+		{
+			acl_node<dim,T> n;
+			n.child = -1;
+			n.start = 0;
+			n.stop = 0;
+
+			nodes.resize(n_top,n);
+			return;
+		}
+
+		// top level cells
+
+		std::vector<size_t> cell(n_part);
+		std::vector<size_t> top_start(n_top+1);
+
+		#pragma omp parallel num_threads(openfpm::cpu_num_threads_for(n_part))
+		{
+			size_t start;
+			size_t stop;
+			openfpm::cpu_chunk(n_part,openfpm::cpu_team_size(),openfpm::cpu_thread_id(),start,stop);
+
+			if (start < stop)
+			{cd.getCellBatch(pos,start,stop,&cell[start]);}
+		}
+
+		openfpm::cpu_bucket_sort(cell.data(),n_part,n_top,&part.template get<0>(0),top_start.data());
+
+		// refine every top level cell in a private buffer of nodes
+
+		nodes.resize(n_top);
+
+		int nt = openfpm::cpu_num_threads_for(n_part);
+		std::vector<std::vector<acl_node<dim,T>>> nb(nt);
+		std::vector<int> top_th(n_top);
+		std::vector<size_t> lev_th(nt);
+
+		#pragma omp parallel num_threads(nt)
+		{
+			int t = openfpm::cpu_thread_id();
+			std::vector<size_t> tmp;
+
+			#pragma omp for schedule(dynamic,16)
+			for (size_t c = 0 ; c < n_top ; c++)
+			{
+				acl_node<dim,T> & n = nodes[c];
+				n.start = top_start[c];
+				n.stop = top_start[c+1];
+
+				calcBox(n,pos);
+
+				Box<dim,T> rg = cd.getCellBox();
+				grid_key_dx<dim> key = cd.getGrid().InvLinId(c);
+				for (size_t d = 0 ; d < dim ; d++)
+				{
+					T l = cd.getDomain().getLow(d) + key.get(d)*cd.getCellBox().getHigh(d);
+					rg.setLow(d,l);
+					rg.setHigh(d,l + cd.getCellBox().getHigh(d));
+				}
+
+				split(n,rg,0,pos,nb[t],tmp,lev_th[t]);
+				top_th[c] = t;
+			}
+		}
+
+		// join the private buffers
+
+		std::vector<size_t> nb_off(nt+1);
+		nb_off[0] = n_top;
+		level = 0;
+		for (int t = 0 ; t < nt ; t++)
+		{
+			nb_off[t+1] = nb_off[t] + nb[t].size();
+			level = (lev_th[t] > level)?lev_th[t]:level;
+		}
+
+		nodes.resize(nb_off[nt]);
+
+		#pragma omp parallel for num_threads(nt) schedule(static)
+		for (int t = 0 ; t < nt ; t++)
+		{
+			for (size_t i = 0 ; i < nb[t].size() ; i++)
+			{
+				acl_node<dim,T> n = nb[t][i];
+				if (n.child != -1)	{n.child += nb_off[t];}
+				nodes[nb_off[t] + i] = n;
+			}
+		}
+
+		for (size_t c = 0 ; c < n_top ; c++)
+		{
+			if (nodes[c].child != -1)	{nodes[c].child += nb_off[top_th[c]];}
+		}
+	}
+
+	/*! \brief Get an iterator across the candidate neighborhood particles of a point
+	 *
+	 * \param xp point
+	 * \param r radius
+	 *
+	 * \return the iterator, it return all the particles closer than r (and some more)
+	 *
+	 */
+	CellListAdaptiveNNIterator<CellListAdaptive<dim,T>> getNNIterator(const Point<dim,T> & xp, T r) const
+	{
+		return CellListAdaptiveNNIterator<CellListAdaptive<dim,T>>(xp,r,*this);
+	}
+
+	/*! \brief Return the node n
+	 *
+	 * \param n node id
+	 *
+	 * \return the node
+	 *
+	 */
+	inline const acl_node<dim,T> & getNode(size_t n) const
+	{
+		return nodes[n];
+	}
+
+	/*! \brief Return the number of nodes (top level cells included)
+	 *
+	 * \return the number of nodes
+	 *
+	 */
+	inline size_t getNNodes() const
+	{
+		return nodes.size();
+	}
+
+	/*! \brief Return the deepest refinement level reached (0 = only top level cells)
+	 *
+	 * \return the level
+	 *
+	 */
+	inline size_t getLevel() const
+	{
+		return level;
+	}
+
+	/*! \brief Return the particle at position i in the leaf ordering
+	 *
+	 * \param i position
+	 *
+	 * \return the particle id
+	 *
+	 */
+	inline size_t getPart(size_t i) const
+	{
+		return part.template get<0>(i);
+	}
+
+	/*! \brief Return the grid of the top level cells
+	 *
+	 * \return the grid
+	 *
+	 */
+	inline const grid_sm<dim,void> & getTopGrid() const
+	{
+		return cd.getGrid();
+	}
+
+	/*! \brief Return the domain
+	 *
+	 * \return the domain
+	 *
+	 */
+	inline const Box<dim,T> & getDomain() const
+	{
+		return cd.getDomain();
+	}
+
+	/*! \brief Return the top level cell box
+	 *
+	 * \return the cell box
+	 *
+	 */
+	inline const Box<dim,T> & getCellBox() const
+	{
+		return cd.getCellBox();
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLLISTADAPTIVE_HPP_ */
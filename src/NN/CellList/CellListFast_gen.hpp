@@ -76,17 +76,8 @@ private:
 				break;
 		}
 
-		grid_key_dx_iterator<dim> it(gs_small);
-
-		while (it.isNext())
-		{
-			auto gk = it.get();
-
-			// Get a key of each cell and add to 'keys' vector
-			SFC.get_hkey(*this,gk,m);
-
-			++it;
-		}
+		// Get a key of each cell
+		SFC.get_hkeys(*this,gs_small,m);
 
 		// Sort and linearize keys
 		SFC.linearize_hkeys(*this,m);
@@ -11,4 +11,11 @@
 constexpr unsigned int NO_CHECK = 1;
 constexpr unsigned int SAFE = 2;
 
+//! cells stored in row-major order
+constexpr unsigned int CL_CELL_ORDER_LINEAR = 0;
+//! cells stored following a Morton (Z) curve
+constexpr unsigned int CL_CELL_ORDER_MORTON = 1;
+//! cells stored following an Hilbert curve
+constexpr unsigned int CL_CELL_ORDER_HILBERT = 2;
+
 #endif /* CELLLIST_DEF_HPP_ */
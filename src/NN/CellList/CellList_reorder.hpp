@@ -0,0 +1,198 @@
+/*
+ * CellList_reorder.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_CELLLIST_CELLLIST_REORDER_HPP_
+#define OPENFPM_DATA_SRC_NN_CELLLIST_CELLLIST_REORDER_HPP_
+
+#include "Vector/map_vector.hpp"
+#include "util/cpu_parallel_util.hpp"
+
+/*! \brief Reorder the particles following the cell structure of a CPU Cell-list
+ *
+ * It is the CPU equivalent of the reordering done by CellList_gpu::construct. The particles
+ * are sorted cell by cell, so that particles in the same cell are contiguous in memory
+ * and particles in neighborhood cells are close. The Cell-list is relabeled to refer to
+ * the sorted particles, the inverse map is kept to scatter back the results. The domain
+ * particles stay before the ghost particles, the Cell-list can be updated with update()
+ * using the sorted positions
+ *
+ * \tparam CellList type of cell-list
+ *
+ * ### Example
+ *
+ * \code
+ * cl.fill(pos,g_m);
+ *
+ * CellList_cpu_reorder<decltype(cl)> rd;
+ * rd.construct(cl);
+ *
+ * rd.reorder(pos,pos_out);
+ * rd.template reorder<0,1>(prp,prp_out);
+ *
+ * // ... interact the particles with cl, pos_out, prp_out
+ *
+ * rd.template scatter<1>(prp_out,prp);
+ * \endcode
+ *
+ */
+template<typename CellList>
+class CellList_cpu_reorder
+{
+	//! for each sorted particle the id in the original vector
+	openfpm::vector<size_t> sorted_to_not_sorted;
+
+	//! for each original particle the id in the sorted vector
+	openfpm::vector<size_t> non_sorted_to_sorted;
+
+public:
+
+	/*! \brief Construct the permutation from the Cell-list
+	 *
+	 * The Cell-list must contain every particle 0 ... N-1 exactly once. After this call
+	 * the cell c of the Cell-list contain the sorted ids, the order of the particles inside
+	 * each cell is preserved. The particles below the marker g_m of fill() (domain) are
+	 * sorted before the particles above it (ghost), the domain particles of a cell are
+	 * consecutive and so are its ghost particles. The marker stay valid, so update() can be
+	 * called with the reordered positions also on a CL_SYMMETRIC Cell-list
+	 *
+	 * \param cl Cell-list (it is relabeled)
+	 *
+	 */
+	void construct(CellList & cl)
+	{
+		size_t n_cell = cl.getNCells();
+
+		// number of particles in each cell
+
+		std::vector<size_t> start(n_cell+1);
+
+		#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(n_cell)) schedule(static)
+		for (size_t c = 0 ; c < n_cell ; c++)
+		{start[c] = cl.getNelements(c);}
+		start[n_cell] = 0;
+
+		openfpm::cpu_scan(start.data(),n_cell+1,start.data());
+
+		size_t n_part = start[n_cell];
+
+		// the cells and the marker saved for update() are valid only if the Cell-list has
+		// been filled with fill(), otherwise all the particles are considered domain and
+		// part_cell is cleared so that update() does a full refill
+
+		bool filled = (cl.part_cell.size() == n_part);
+		size_t g_m = (filled == true)?std::min(cl.fill_g_m,n_part):n_part;
+
+		// domain particles start at start[c], ghost particles at start_g[c]
+
+		std::vector<size_t> start_g(n_cell+1,0);
+
+		if (g_m != n_part)
+		{
+			#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(n_part + n_cell)) schedule(static)
+			for (size_t c = 0 ; c < n_cell ; c++)
+			{
+				size_t n_ele = cl.getNelements(c);
+				size_t n_dom = 0;
+
+				for (size_t j = 0 ; j < n_ele ; j++)
+				{n_dom += (cl.get(c,j) < g_m)?1:0;}
+
+				start[c] = n_dom;
+				start_g[c] = n_ele - n_dom;
+			}
+			start[n_cell] = 0;
+			start_g[n_cell] = 0;
+
+			openfpm::cpu_scan(start.data(),n_cell+1,start.data());
+			openfpm::cpu_scan(start_g.data(),n_cell+1,start_g.data());
+		}
+
+		sorted_to_not_sorted.resize(n_part);
+		non_sorted_to_sorted.resize(n_part);
+
+		#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(n_part + n_cell)) schedule(static)
+		for (size_t c = 0 ; c < n_cell ; c++)
+		{
+			size_t s_dom = start[c];
+			size_t s_gh = g_m + start_g[c];
+
+			for (size_t j = 0 ; j < cl.getNelements(c) ; j++)
+			{
+				size_t p = cl.get(c,j);
+				size_t s = (p < g_m)?s_dom++:s_gh++;
+
+				sorted_to_not_sorted.get(s) = p;
+				non_sorted_to_sorted.get(p) = s;
+
+				cl.get(c,j) = s;
+			}
+		}
+
+		if (filled == true)
+		{
+			openfpm::vector<typename CellList::local_index_type> part_cell(n_part);
+
+			#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(n_part)) schedule(static)
+			for (size_t s = 0 ; s < n_part ; s++)
+			{part_cell.get(s) = cl.part_cell.get(sorted_to_not_sorted.get(s));}
+
+			cl.part_cell.swap(part_cell);
+		}
+		else
+		{cl.part_cell.clear();}
+	}
+
+	/*! \brief Copy the vector v_in into v_out in cell order
+	 *
+	 * \tparam prp properties to copy (all if none is specified)
+	 *
+	 * \param v_in vector in the original order (positions or properties)
+	 * \param v_out vector in the sorted order
+	 *
+	 */
+	template<unsigned int ... prp, typename vector_type>
+	void reorder(vector_type & v_in, vector_type & v_out)
+	{
+		v_out.template gather<prp...>(v_in,sorted_to_not_sorted);
+	}
+
+	/*! \brief Copy back a vector in cell order into the original order
+	 *
+	 * \tparam prp properties to copy (all if none is specified)
+	 *
+	 * \param v_sorted vector in the sorted order
+	 * \param v_out vector in the original order (must have at least the size of v_sorted)
+	 *
+	 */
+	template<unsigned int ... prp, typename vector_type>
+	void scatter(vector_type & v_sorted, vector_type & v_out)
+	{
+		v_sorted.template scatter<prp...>(v_out,sorted_to_not_sorted);
+	}
+
+	/*! \brief Return the map from sorted id to original id
+	 *
+	 * \return the map sorted to not sorted
+	 *
+	 */
+	openfpm::vector<size_t> & getSortToNonSort()
+	{
+		return sorted_to_not_sorted;
+	}
+
+	/*! \brief Return the map from original id to sorted id
+	 *
+	 * \return the map not sorted to sorted
+	 *
+	 */
+	openfpm::vector<size_t> & getNonSortToSort()
+	{
+		return non_sorted_to_sorted;
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLLIST_REORDER_HPP_ */
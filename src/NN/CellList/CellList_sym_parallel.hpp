@@ -0,0 +1,300 @@
+/*
+ * CellList_sym_parallel.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_CELLLIST_CELLLIST_SYM_PARALLEL_HPP_
+#define OPENFPM_DATA_SRC_NN_CELLLIST_CELLLIST_SYM_PARALLEL_HPP_
+
+#include "NN/CellList/CellList.hpp"
+#include "util/copy_compare/meta_copy.hpp"
+#include "util/copy_compare/copy_general.hpp"
+#include "util/cpu_parallel_util.hpp"
+
+/*! \brief Set to zero a property of an element (scalar or array of any dimension)
+ *
+ * \tparam T type of the property
+ *
+ */
+template<typename T>
+struct sym_acc_zero
+{
+	/*! \brief Set to zero
+	 *
+	 * \param dst property of an element
+	 *
+	 */
+	template<typename Tdst> static inline void set(Tdst && dst)
+	{
+		dst = 0;
+	}
+};
+
+//! Partial specialization for arrays
+template<typename T, size_t N1>
+struct sym_acc_zero<T[N1]>
+{
+	/*! \brief Set to zero every component
+	 *
+	 * \param dst property of an element
+	 *
+	 */
+	template<typename Tdst> static inline void set(Tdst && dst)
+	{
+		for (size_t i = 0 ; i < N1 ; i++)
+		{sym_acc_zero<T>::set(dst[i]);}
+	}
+};
+
+/*! \brief Parallel symmetric (half-shell) interaction driver for a CPU Cell-list
+ *
+ * With the symmetric traversal (getNNIteratorSym) every pair p,q is visited once and the
+ * interaction is written on both particles. The particles written while processing the
+ * cell c are in c and in its half-shell, that in cell units is [-1,1] on the first dim-1
+ * dimensions and [0,1] on the last one. Cells are colored with
+ *
+ * color = sum_{d < dim-1} (c_d % 3) * 3^d + (c_{dim-1} % 2) * 3^(dim-1)
+ *
+ * two different cells with the same color are at least 3 cells apart on one of the first
+ * dim-1 dimensions or 2 cells apart on the last one, so they write disjoint sets of
+ * particles. The colors are processed one after the other, the cells of a color in parallel
+ * without atomics.
+ *
+ * For small systems (few cells per color) forEachPairReduce process all the cells in
+ * parallel and accumulate in a thread-private copy of one property, the copies are reduced
+ * at the end
+ *
+ * \tparam CellList_type type of cell-list (filled with the option CL_SYMMETRIC)
+ *
+ * ### Example
+ *
+ * \code
+ * cl.fill(pos,g_m,CL_SYMMETRIC);
+ *
+ * CellList_sym_parallel<decltype(cl)> sp;
+ * sp.construct(cl);
+ *
+ * sp.forEachPair(pos,[&](size_t p, size_t q)
+ * {
+ *     // ... interaction written on p and q
+ * });
+ * \endcode
+ *
+ */
+template<typename CellList_type>
+class CellList_sym_parallel
+{
+	//! dimensionality
+	static const unsigned int dim = CellList_type::dims;
+
+	//! Cell-list
+	CellList_type * cl = NULL;
+
+	//! start of the cells of each color in cells
+	openfpm::vector<aggregate<size_t>> color_start;
+
+	//! domain cells ordered by color
+	openfpm::vector<aggregate<size_t>> cells;
+
+	/*! \brief Visit the pairs of the particles in the cell c
+	 *
+	 * \param c cell
+	 * \param pos particle positions
+	 * \param f function called with every pair
+	 *
+	 */
+	template<typename vector_pos_type, typename lambda_type>
+	inline void cell_pairs(size_t c, const vector_pos_type & pos, lambda_type & f)
+	{
+		for (size_t j = 0 ; j < cl->getNelements(c) ; j++)
+		{
+			size_t p = cl->get(c,j);
+
+			auto NN = cl->template getNNIteratorSym<NO_CHECK>(c,p,pos);
+
+			while (NN.isNext())
+			{
+				size_t q = NN.get();
+
+				if (q != p)	{f(p,q);}
+
+				++NN;
+			}
+		}
+	}
+
+public:
+
+	//! number of colors
+	static const size_t n_colors = openfpm::math::pow(3,dim-1)*2;
+
+	/*! \brief Color the domain cells of the Cell-list
+	 *
+	 * It has to be called again only if the Cell-list is re-initialized (the cells change)
+	 *
+	 * \param cl Cell-list
+	 *
+	 */
+	void construct(CellList_type & cl)
+	{
+		this->cl = &cl;
+
+		const grid_sm<dim,void> & gr = cl.getInternalGrid();
+
+		size_t start[dim];
+		size_t stop[dim];
+
+		for (size_t d = 0 ; d < dim ; d++)
+		{
+			start[d] = cl.getPadding(d);
+			stop[d] = gr.size(d) - cl.getPadding(d) - 1;
+		}
+
+		// count the cells of each color and bucket them
+
+		color_start.resize(n_colors+1);
+		color_start.template fill<0>(0);
+
+		openfpm::vector<aggregate<size_t>> color;
+		cells.clear();
+
+		grid_key_dx_iterator_sub<dim> it(gr,start,stop);
+
+		while (it.isNext())
+		{
+			auto key = it.get();
+
+			size_t col = 0;
+			size_t mul = 1;
+			for (size_t d = 0 ; d < dim - 1 ; d++, mul *= 3)
+			{col += (key.get(d) % 3) * mul;}
+			col += (key.get(dim-1) % 2) * mul;
+
+			color.add();
+			color.template get<0>(color.size()-1) = col;
+			color_start.template get<0>(col)++;
+
+			cells.add();
+			cells.template get<0>(cells.size()-1) = gr.LinId(key);
+
+			++it;
+		}
+
+		openfpm::cpu_scan(&color_start.template get<0>(0),n_colors+1,&color_start.template get<0>(0));
+
+		openfpm::vector<aggregate<size_t>> cells_col;
+		cells_col.resize(cells.size());
+
+		for (size_t i = 0 ; i < cells.size() ; i++)
+		{
+			size_t & s = color_start.template get<0>(color.template get<0>(i));
+			cells_col.template get<0>(s) = cells.template get<0>(i);
+			s++;
+		}
+
+		// shift back the starts
+
+		for (size_t i = n_colors ; i > 0 ; i--)
+		{color_start.template get<0>(i) = color_start.template get<0>(i-1);}
+		color_start.template get<0>(0) = 0;
+
+		cells.swap(cells_col);
+	}
+
+	/*! \brief Call f(p,q) for every pair of particles of the symmetric traversal
+	 *
+	 * The same pairs as getNNIteratorSym are visited (p != q). Inside a color the cells are
+	 * processed in parallel, f can write both on p and q without atomics
+	 *
+	 * \param pos particle positions (the one used to fill the Cell-list)
+	 * \param f function called with every pair
+	 *
+	 */
+	template<typename vector_pos_type, typename lambda_type>
+	void forEachPair(const vector_pos_type & pos, lambda_type f)
+	{
+		for (size_t col = 0 ; col < n_colors ; col++)
+		{
+			size_t c_start = color_start.template get<0>(col);
+			size_t c_stop = color_start.template get<0>(col+1);
+
+			#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(pos.size())) schedule(dynamic,8)
+			for (size_t i = c_start ; i < c_stop ; i++)
+			{cell_pairs(cells.template get<0>(i),pos,f);}
+		}
+	}
+
+	/*! \brief Call f(p,q,acc) for every pair of particles of the symmetric traversal
+	 * accumulating into a thread-private copy of the property prp
+	 *
+	 * The cells are processed in parallel without coloring, every thread write into its
+	 * own copy of v_acc (the first thread into v_acc itself), the copies are summed into
+	 * v_acc at the end. Convenient when the number of cells is small
+	 *
+	 * \tparam prp property accumulated
+	 *
+	 * \param pos particle positions (the one used to fill the Cell-list)
+	 * \param v_acc vector that contain the property prp to accumulate into
+	 * \param f function called with every pair f(p,q,acc), acc is the vector to write
+	 *
+	 */
+	template<unsigned int prp, typename vector_pos_type, typename vector_acc_type, typename lambda_type>
+	void forEachPairReduce(const vector_pos_type & pos, vector_acc_type & v_acc, lambda_type f)
+	{
+		typedef typename boost::remove_reference<decltype(v_acc.template get<prp>(0))>::type acc_rtype;
+		typedef typename boost::mpl::at<typename vector_acc_type::value_type::type,boost::mpl::int_<prp>>::type acc_type;
+
+		size_t nth = openfpm::cpu_num_threads_for(pos.size());
+		std::vector<vector_acc_type> acc_th(nth);
+
+		#pragma omp parallel num_threads(nth)
+		{
+			int t = openfpm::cpu_thread_id();
+
+			vector_acc_type * acc = &v_acc;
+
+			if (t != 0)
+			{
+				acc_th[t].resize(v_acc.size());
+
+				for (size_t i = 0 ; i < acc_th[t].size() ; i++)
+				{sym_acc_zero<acc_type>::set(acc_th[t].template get<prp>(i));}
+
+				acc = &acc_th[t];
+			}
+
+			auto fa = [&](size_t p, size_t q){f(p,q,*acc);};
+
+			#pragma omp for schedule(dynamic,8)
+			for (size_t i = 0 ; i < cells.size() ; i++)
+			{cell_pairs(cells.template get<0>(i),pos,fa);}
+		}
+
+		// reduction
+
+		#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(v_acc.size())) schedule(static)
+		for (size_t i = 0 ; i < v_acc.size() ; i++)
+		{
+			for (size_t t = 1 ; t < nth ; t++)
+			{
+				if (acc_th[t].size() == 0)	{continue;}
+
+				meta_copy_op<add_,acc_rtype>::meta_copy_op_(acc_th[t].template get<prp>(i),v_acc.template get<prp>(i));
+			}
+		}
+	}
+
+	/*! \brief Return the number of domain cells
+	 *
+	 * \return the number of cells
+	 *
+	 */
+	size_t getNCells() const
+	{
+		return cells.size();
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLLIST_SYM_PARALLEL_HPP_ */
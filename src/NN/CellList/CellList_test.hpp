@@ -7,7 +7,10 @@
 
 #include "CellList.hpp"
 #include "CellListM.hpp"
+#include "CellList_reorder.hpp"
+#include "CellList_sym_parallel.hpp"
 #include "Grid/grid_sm.hpp"
+#include <random>
 
 #ifndef CELLLIST_TEST_HPP_
 #define CELLLIST_TEST_HPP_
@@ -43,6 +46,8 @@ template<unsigned int dim, typename T, typename CellS> void Test_cell_s(SpaceBox
 		cl2.add(org,i);
 	}
 
+	cl2.finalize();
+
 	// Check the elements
 	BOOST_REQUIRE_EQUAL(cl2.getNelements(cl2.getCell(org)),CELL_REALLOC * 3ul);
 	for (size_t i = 0 ; i < CELL_REALLOC * 3 ; i++)
@@ -98,6 +103,8 @@ template<unsigned int dim, typename T, typename CellS> void Test_cell_s(SpaceBox
 		++g_it;
 	}
 
+	cl1.finalize();
+
 	//! [Usage of cell list]
 
 	// check the cell are correctly filled
@@ -322,6 +329,783 @@ template<unsigned int dim, typename T, typename CellS> void Test_cell_sM(SpaceBo
 
 
 
+/*! \brief Test that the bulk fill produce the same cell list of the serial add
+ *
+ * \tparam CellS
+ *
+ */
+template<unsigned int dim, typename T, typename CellS> void Test_cell_fill(SpaceBox<dim,T> & box)
+{
+	size_t div[dim] = {16,16,16};
+
+	// clustered particles force the reallocation in Mem_fast
+	openfpm::vector<Point<dim,T>> pos;
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<T> ud(0.0,1.0);
+
+	for (size_t i = 0 ; i < 50000 ; i++)
+	{
+		Point<dim,T> p;
+		T scale = (i % 2 == 0)?1.0:0.1;
+
+		for (size_t j = 0 ; j < dim ; j++)
+		{p.get(j) = box.getLow(j) + scale*ud(eg)*(box.getHigh(j) - box.getLow(j));}
+
+		pos.add(p);
+	}
+
+	size_t g_m = pos.size() / 2;
+
+	for (size_t opt = CL_SYMMETRIC ; opt <= CL_NON_SYMMETRIC ; opt++)
+	{
+		CellS cl_ser(box,div);
+		CellS cl_fill(box,div);
+
+		// put something inside to check that fill clear the old content
+		cl_fill.add(pos.get(0),7);
+
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{
+			if (opt == CL_SYMMETRIC && i < g_m)
+			{cl_ser.addDom(pos.get(i),i);}
+			else if (opt == CL_SYMMETRIC)
+			{cl_ser.addPad(pos.get(i),i);}
+			else
+			{cl_ser.add(pos.get(i),i);}
+		}
+
+		cl_ser.finalize();
+
+		cl_fill.fill(pos,g_m,opt);
+
+		BOOST_REQUIRE_EQUAL(cl_ser.getNCells(),cl_fill.getNCells());
+
+		for (size_t c = 0 ; c < cl_ser.getNCells() ; c++)
+		{
+			BOOST_REQUIRE_EQUAL(cl_ser.getNelements(c),cl_fill.getNelements(c));
+
+			for (size_t j = 0 ; j < cl_ser.getNelements(c) ; j++)
+			{BOOST_REQUIRE_EQUAL(cl_ser.get(c,j),cl_fill.get(c,j));}
+		}
+	}
+}
+
+/*! \brief Test the incremental update of the cell-list
+ *
+ * \tparam CellS type of cell-list
+ *
+ */
+template<unsigned int dim, typename T, typename CellS> void Test_cell_update(SpaceBox<dim,T> & box)
+{
+	size_t div[dim] = {16,16,16};
+
+	openfpm::vector<Point<dim,T>> pos;
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<T> ud(0.0,1.0);
+
+	for (size_t i = 0 ; i < 20000 ; i++)
+	{
+		Point<dim,T> p;
+
+		for (size_t j = 0 ; j < dim ; j++)
+		{p.get(j) = box.getLow(j) + ud(eg)*(box.getHigh(j) - box.getLow(j));}
+
+		pos.add(p);
+	}
+
+	size_t g_m = pos.size() / 2;
+
+	for (size_t opt = CL_SYMMETRIC ; opt <= CL_NON_SYMMETRIC ; opt++)
+	{
+		CellS cl_up(box,div);
+		cl_up.fill(pos,g_m,opt);
+
+		// move 1%, 10% and 50% of the particles
+
+		size_t fr[3] = {100,10,2};
+
+		for (size_t k = 0 ; k < 3 ; k++)
+		{
+			for (size_t i = 0 ; i < pos.size() ; i += fr[k])
+			{
+				for (size_t j = 0 ; j < dim ; j++)
+				{pos.template get<0>(i)[j] = box.getLow(j) + ud(eg)*(box.getHigh(j) - box.getLow(j));}
+			}
+
+			CellS cl_fill(box,div);
+			cl_fill.fill(pos,g_m,opt);
+
+			cl_up.update(pos);
+
+			for (size_t c = 0 ; c < cl_fill.getNCells() ; c++)
+			{
+				BOOST_REQUIRE_EQUAL(cl_up.getNelements(c),cl_fill.getNelements(c));
+
+				openfpm::vector<size_t> e_up;
+				openfpm::vector<size_t> e_fill;
+
+				for (size_t j = 0 ; j < cl_fill.getNelements(c) ; j++)
+				{
+					e_up.add(cl_up.get(c,j));
+					e_fill.add(cl_fill.get(c,j));
+				}
+
+				e_up.sort();
+
+				for (size_t j = 0 ; j < e_fill.size() ; j++)
+				{BOOST_REQUIRE_EQUAL(e_up.get(j),e_fill.get(j));}
+			}
+		}
+
+		// nothing moved
+
+		BOOST_REQUIRE_EQUAL(cl_up.update(pos),0ul);
+	}
+}
+
+/*! \brief Compare the content of two cell-lists cell by cell and with the neighborhood iterator
+ *
+ * \param cl1 first cell-list
+ * \param cl2 second cell-list
+ *
+ */
+template<typename CellS, typename CellS2> void Test_cell_same_content(CellS & cl1, CellS2 & cl2)
+{
+	BOOST_REQUIRE_EQUAL(cl1.getNCells(),cl2.getNCells());
+
+	bool ret = true;
+
+	for (size_t c = 0 ; c < cl1.getNCells() ; c++)
+	{
+		openfpm::vector<size_t> e1;
+		openfpm::vector<size_t> e2;
+
+		for (size_t j = 0 ; j < cl1.getNelements(c) ; j++)
+		{e1.add(cl1.get(c,j));}
+
+		for (size_t j = 0 ; j < cl2.getNelements(c) ; j++)
+		{e2.add(cl2.get(c,j));}
+
+		e1.sort();
+		e2.sort();
+
+		ret &= (e1.size() == e2.size());
+		for (size_t j = 0 ; j < e1.size() && j < e2.size() ; j++)
+		{ret &= (e1.get(j) == e2.get(j));}
+	}
+
+	// neighborhood of the domain cells
+
+	size_t start[3];
+	size_t stop[3];
+
+	for (size_t d = 0 ; d < 3 ; d++)
+	{
+		start[d] = 1;
+		stop[d] = cl1.getInternalGrid().size(d) - 2;
+	}
+
+	grid_key_dx_iterator_sub<3> it(cl1.getInternalGrid(),start,stop);
+
+	while (it.isNext())
+	{
+		size_t c = cl1.getInternalGrid().LinId(it.get());
+
+		openfpm::vector<size_t> n1;
+		openfpm::vector<size_t> n2;
+
+		auto NN1 = cl1.template getNNIterator<NO_CHECK>(c);
+		while (NN1.isNext())
+		{
+			n1.add(NN1.get());
+			++NN1;
+		}
+
+		auto NN2 = cl2.template getNNIterator<NO_CHECK>(c);
+		while (NN2.isNext())
+		{
+			n2.add(NN2.get());
+			++NN2;
+		}
+
+		n1.sort();
+		n2.sort();
+
+		ret &= (n1.size() == n2.size());
+		for (size_t j = 0 ; j < n1.size() && j < n2.size() ; j++)
+		{ret &= (n1.get(j) == n2.get(j));}
+
+		++it;
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+}
+
+/*! \brief Test a cell-list with the cells stored following a space-filling curve against the row-major one
+ *
+ * \tparam CellS_lin type of cell-list with the cells in row-major order
+ * \tparam CellS type of cell-list with the cells following a space-filling curve
+ *
+ * \param order order of the cells of CellS
+ *
+ */
+template<typename CellS_lin, typename CellS> void Test_cell_order(size_t order)
+{
+	SpaceBox<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+
+	// not a power of two
+	size_t div[3] = {10,13,7};
+
+	openfpm::vector<Point<3,double>> pos;
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<double> ud(0.0,1.0);
+	std::uniform_real_distribution<double> ug(-0.05,1.05);
+
+	for (size_t i = 0 ; i < 10000 ; i++)
+	{pos.add(Point<3,double>({ug(eg),ug(eg),ug(eg)}));}
+
+	CellS_lin cl_lin(box,div);
+	CellS cl_z(box,div);
+	CellS cl_add(box,div);
+
+	BOOST_REQUIRE_EQUAL(cl_lin.getCellOrder(),CL_CELL_ORDER_LINEAR);
+	BOOST_REQUIRE_EQUAL(cl_z.getCellOrder(),order);
+
+	cl_lin.fill(pos,pos.size());
+	cl_z.fill(pos,pos.size());
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{cl_add.add(pos.get(i),i);}
+
+	cl_add.finalize();
+
+	Test_cell_same_content(cl_lin,cl_z);
+	Test_cell_same_content(cl_lin,cl_add);
+
+	// update
+
+	for (size_t i = 0 ; i < pos.size() ; i += 10)
+	{pos.get(i) = Point<3,double>({ug(eg),ug(eg),ug(eg)});}
+
+	cl_lin.fill(pos,pos.size());
+	cl_z.update(pos);
+
+	Test_cell_same_content(cl_lin,cl_z);
+
+	// k nearest neighbors
+
+	openfpm::vector<aggregate<typename CellS_lin::value_type,double>> out_lin;
+	openfpm::vector<aggregate<typename CellS::value_type,double>> out_z;
+
+	for (size_t i = 0 ; i < 100 ; i++)
+	{
+		Point<3,double> xp({ud(eg),ud(eg),ud(eg)});
+
+		cl_lin.knn(xp,10,pos,out_lin);
+		cl_z.knn(xp,10,pos,out_z);
+
+		BOOST_REQUIRE_EQUAL(out_lin.size(),out_z.size());
+		for (size_t j = 0 ; j < out_lin.size() ; j++)
+		{BOOST_REQUIRE_EQUAL(out_lin.template get<0>(j),out_z.template get<0>(j));}
+	}
+
+	// the order survive copy and re-initialization
+
+	CellS cl_cp = cl_z;
+	BOOST_REQUIRE_EQUAL(cl_cp.getCellOrder(),order);
+	Test_cell_same_content(cl_lin,cl_cp);
+
+	size_t div2[3] = {8,9,11};
+	cl_lin.Initialize(box,div2);
+	cl_z.Initialize(box,div2);
+
+	cl_lin.fill(pos,pos.size());
+	cl_z.fill(pos,pos.size());
+
+	Test_cell_same_content(cl_lin,cl_z);
+}
+
+/*! \brief Test the k nearest neighbors query against brute force
+ *
+ * \tparam CellS type of cell-list
+ *
+ */
+template<typename CellS> void Test_cell_knn()
+{
+	SpaceBox<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {10,10,10};
+
+	openfpm::vector<Point<3,double>> pos;
+	openfpm::vector<Point<3,double>> queries;
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<double> ud(0.0,1.0);
+
+	for (size_t i = 0 ; i < 5000 ; i++)
+	{pos.add(Point<3,double>({ud(eg),ud(eg),ud(eg)}));}
+
+	for (size_t i = 0 ; i < 300 ; i++)
+	{queries.add(Point<3,double>({ud(eg),ud(eg),ud(eg)}));}
+
+	CellS cl(box,div);
+	cl.fill(pos,pos.size());
+
+	size_t k = 20;
+
+	openfpm::vector<aggregate<typename CellS::value_type,double>> out;
+	openfpm::vector<aggregate<typename CellS::value_type,double>> out_b;
+
+	size_t kk = cl.knnBatch(queries,k,pos,out_b);
+	BOOST_REQUIRE_EQUAL(kk,k);
+
+	bool ret = true;
+
+	for (size_t i = 0 ; i < queries.size() ; i++)
+	{
+		Point<3,double> xp = queries.get(i);
+
+		cl.knn(xp,k,pos,out);
+		BOOST_REQUIRE_EQUAL(out.size(),k);
+
+		// brute force
+
+		openfpm::vector<std::pair<double,size_t>> bf;
+		for (size_t j = 0 ; j < pos.size() ; j++)
+		{bf.add(std::make_pair(xp.distance2(pos.get(j)),j));}
+
+		std::sort(bf.begin(),bf.end());
+
+		for (size_t j = 0 ; j < k ; j++)
+		{
+			ret &= (out.template get<0>(j) == bf.get(j).second);
+			ret &= (out.template get<1>(j) == bf.get(j).first);
+			ret &= (out_b.template get<0>(i*k+j) == bf.get(j).second);
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+
+	// more neighbors than particles
+
+	CellS cl_small(box,div);
+	pos.resize(7);
+	cl_small.fill(pos,pos.size());
+
+	cl_small.knn(queries.get(0),k,pos,out);
+	BOOST_REQUIRE_EQUAL(out.size(),7ul);
+	BOOST_REQUIRE_EQUAL(cl_small.knnBatch(queries,k,pos,out_b),7ul);
+}
+
+/*! \brief Test the batched range queries against brute force
+ *
+ * \tparam CellS type of cell-list
+ *
+ */
+template<typename CellS> void Test_cell_range_batch()
+{
+	SpaceBox<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {10,10,10};
+
+	openfpm::vector<Point<3,double>> pos;
+	openfpm::vector<Point<3,double>> queries;
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<double> ud(0.0,1.0);
+
+	for (size_t i = 0 ; i < 5000 ; i++)
+	{pos.add(Point<3,double>({ud(eg),ud(eg),ud(eg)}));}
+
+	// grid nodes as queries
+	for (size_t i = 0 ; i <= 8 ; i++)
+	{
+		for (size_t j = 0 ; j <= 8 ; j++)
+		{
+			for (size_t k = 0 ; k <= 8 ; k++)
+			{queries.add(Point<3,double>({i/8.0,j/8.0,k/8.0}));}
+		}
+	}
+
+	CellS cl(box,div);
+	cl.fill(pos,pos.size());
+
+	openfpm::vector<aggregate<typename CellS::value_type>> start;
+	openfpm::vector<aggregate<typename CellS::value_type>> ids;
+
+	// radius smaller and bigger than the cells
+
+	double rs[2] = {0.07,0.23};
+
+	for (size_t ir = 0 ; ir < 2 ; ir++)
+	{
+		double r = rs[ir];
+
+		cl.rangeQueryBatch(queries,r,pos,start,ids);
+
+		BOOST_REQUIRE_EQUAL(start.size(),queries.size()+1);
+		BOOST_REQUIRE_EQUAL(start.template get<0>(queries.size()),ids.size());
+
+		bool ret = true;
+
+		for (size_t i = 0 ; i < queries.size() ; i++)
+		{
+			Point<3,double> xp = queries.get(i);
+
+			openfpm::vector<size_t> bf;
+			for (size_t j = 0 ; j < pos.size() ; j++)
+			{
+				if (xp.distance2(pos.get(j)) < r*r)
+				{bf.add(j);}
+			}
+
+			openfpm::vector<size_t> rq;
+			for (size_t j = start.template get<0>(i) ; j < start.template get<0>(i+1) ; j++)
+			{rq.add(ids.template get<0>(j));}
+
+			rq.sort();
+
+			ret &= (rq.size() == bf.size());
+			for (size_t j = 0 ; j < rq.size() && j < bf.size() ; j++)
+			{ret &= (rq.get(j) == bf.get(j));}
+		}
+
+		BOOST_REQUIRE_EQUAL(ret,true);
+	}
+}
+
+/*! \brief Test the parallel symmetric interaction driver
+ *
+ * \tparam CellS type of cell-list
+ *
+ */
+template<typename CellS> void Test_cell_sym_parallel()
+{
+	SpaceBox<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {20,20,20};
+	double r_cut = 0.05;
+
+	openfpm::vector<Point<3,double>> pos;
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<double> ud(0.0,1.0);
+
+	for (size_t i = 0 ; i < 40000 ; i++)
+	{pos.add(Point<3,double>({ud(eg),ud(eg),ud(eg)}));}
+
+	CellS cl(box,div);
+	cl.fill(pos,pos.size(),CL_SYMMETRIC);
+
+	// reference with the full neighborhood
+
+	openfpm::vector<aggregate<size_t,double[3]>> ref;
+	ref.resize(pos.size());
+
+	for (size_t p = 0 ; p < pos.size() ; p++)
+	{
+		Point<3,double> xp = pos.get(p);
+
+		ref.template get<0>(p) = 0;
+		for (size_t d = 0 ; d < 3 ; d++)	{ref.template get<1>(p)[d] = 0.0;}
+
+		auto NN = cl.template getNNIterator<NO_CHECK>(cl.getCell(xp));
+		while (NN.isNext())
+		{
+			size_t q = NN.get();
+			Point<3,double> xq = pos.get(q);
+			Point<3,double> dx = xp - xq;
+
+			if (q != p && dx.norm() < r_cut)
+			{
+				ref.template get<0>(p)++;
+				for (size_t d = 0 ; d < 3 ; d++)	{ref.template get<1>(p)[d] += dx.get(d);}
+			}
+
+			++NN;
+		}
+	}
+
+	CellList_sym_parallel<CellS> sp;
+	sp.construct(cl);
+
+	BOOST_REQUIRE_EQUAL(sp.getNCells(),20ul*20ul*20ul);
+
+	openfpm::vector<aggregate<size_t,double[3]>> prp;
+	prp.resize(pos.size());
+
+	for (size_t p = 0 ; p < prp.size() ; p++)
+	{
+		prp.template get<0>(p) = 0;
+		for (size_t d = 0 ; d < 3 ; d++)	{prp.template get<1>(p)[d] = 0.0;}
+	}
+
+	sp.forEachPair(pos,[&](size_t p, size_t q)
+	{
+		Point<3,double> xp = pos.get(p);
+		Point<3,double> xq = pos.get(q);
+		Point<3,double> dx = xp - xq;
+		if (dx.norm() >= r_cut)	{return;}
+
+		prp.template get<0>(p)++;
+		prp.template get<0>(q)++;
+
+		for (size_t d = 0 ; d < 3 ; d++)
+		{
+			prp.template get<1>(p)[d] += dx.get(d);
+			prp.template get<1>(q)[d] -= dx.get(d);
+		}
+	});
+
+	openfpm::vector<aggregate<size_t,double[3]>> prp_r;
+	prp_r.resize(pos.size());
+
+	for (size_t p = 0 ; p < prp_r.size() ; p++)
+	{
+		for (size_t d = 0 ; d < 3 ; d++)	{prp_r.template get<1>(p)[d] = 0.0;}
+	}
+
+	sp.template forEachPairReduce<1>(pos,prp_r,[&](size_t p, size_t q, openfpm::vector<aggregate<size_t,double[3]>> & acc)
+	{
+		Point<3,double> xp = pos.get(p);
+		Point<3,double> xq = pos.get(q);
+		Point<3,double> dx = xp - xq;
+		if (dx.norm() >= r_cut)	{return;}
+
+		for (size_t d = 0 ; d < 3 ; d++)
+		{
+			acc.template get<1>(p)[d] += dx.get(d);
+			acc.template get<1>(q)[d] -= dx.get(d);
+		}
+	});
+
+	// the same with the accumulator property in a memory_traits_inte vector
+
+	typedef openfpm::vector<aggregate<size_t,double[3]>,HeapMemory,memory_traits_inte> vector_inte;
+
+	vector_inte prp_ri;
+	prp_ri.resize(pos.size());
+
+	for (size_t p = 0 ; p < prp_ri.size() ; p++)
+	{
+		for (size_t d = 0 ; d < 3 ; d++)	{prp_ri.template get<1>(p)[d] = 0.0;}
+	}
+
+	sp.template forEachPairReduce<1>(pos,prp_ri,[&](size_t p, size_t q, vector_inte & acc)
+	{
+		Point<3,double> xp = pos.get(p);
+		Point<3,double> xq = pos.get(q);
+		Point<3,double> dx = xp - xq;
+		if (dx.norm() >= r_cut)	{return;}
+
+		for (size_t d = 0 ; d < 3 ; d++)
+		{
+			acc.template get<1>(p)[d] += dx.get(d);
+			acc.template get<1>(q)[d] -= dx.get(d);
+		}
+	});
+
+	bool ret = true;
+	for (size_t p = 0 ; p < pos.size() ; p++)
+	{
+		ret &= (prp.template get<0>(p) == ref.template get<0>(p));
+
+		for (size_t d = 0 ; d < 3 ; d++)
+		{
+			ret &= (fabs(prp.template get<1>(p)[d] - ref.template get<1>(p)[d]) < 1e-10);
+			ret &= (fabs(prp_r.template get<1>(p)[d] - ref.template get<1>(p)[d]) < 1e-10);
+			ret &= (fabs(prp_ri.template get<1>(p)[d] - ref.template get<1>(p)[d]) < 1e-10);
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+}
+
+/*! \brief Test the reordering of the particles following the cell-list
+ *
+ * \tparam layout_base memory layout of the properties
+ *
+ */
+template<template <typename> class layout_base> void Test_cell_reorder()
+{
+	SpaceBox<3,float> box({0.0f,0.0f,0.0f},{1.0f,1.0f,1.0f});
+	size_t div[3] = {8,8,8};
+
+	typedef aggregate<float,float[3],size_t> prop;
+
+	openfpm::vector<Point<3,float>> pos;
+	openfpm::vector<prop,HeapMemory,layout_base> prp;
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<float> ud(0.0,1.0);
+
+	for (size_t i = 0 ; i < 20000 ; i++)
+	{
+		pos.add();
+		prp.add();
+
+		for (size_t j = 0 ; j < 3 ; j++)
+		{
+			pos.template get<0>(i)[j] = ud(eg);
+			prp.template get<1>(i)[j] = i + j;
+		}
+
+		prp.template get<0>(i) = i;
+		prp.template get<2>(i) = 2*i;
+	}
+
+	CellList<3,float,Mem_fast<>> cl(box,div);
+	cl.fill(pos,pos.size());
+
+	CellList_cpu_reorder<decltype(cl)> rd;
+	rd.construct(cl);
+
+	openfpm::vector<Point<3,float>> pos_out;
+	openfpm::vector<prop,HeapMemory,layout_base> prp_out;
+
+	rd.reorder(pos,pos_out);
+	rd.template reorder<0,1>(prp,prp_out);
+
+	auto & s2ns = rd.getSortToNonSort();
+	auto & ns2s = rd.getNonSortToSort();
+
+	BOOST_REQUIRE_EQUAL(pos_out.size(),pos.size());
+	BOOST_REQUIRE_EQUAL(prp_out.size(),prp.size());
+
+	for (size_t i = 0 ; i < pos_out.size() ; i++)
+	{
+		size_t src = s2ns.get(i);
+
+		BOOST_REQUIRE_EQUAL(ns2s.get(src),i);
+
+		for (size_t j = 0 ; j < 3 ; j++)
+		{
+			BOOST_REQUIRE_EQUAL(pos_out.template get<0>(i)[j],pos.template get<0>(src)[j]);
+			BOOST_REQUIRE_EQUAL(prp_out.template get<1>(i)[j],prp.template get<1>(src)[j]);
+		}
+
+		BOOST_REQUIRE_EQUAL(prp_out.template get<0>(i),prp.template get<0>(src));
+	}
+
+	// the cell-list refer to the sorted particles, every cell is a contiguous range
+
+	size_t expected = 0;
+	for (size_t c = 0 ; c < cl.getNCells() ; c++)
+	{
+		for (size_t j = 0 ; j < cl.getNelements(c) ; j++)
+		{
+			size_t p = cl.get(c,j);
+
+			BOOST_REQUIRE_EQUAL(p,expected);
+			BOOST_REQUIRE_EQUAL(cl.getCell(pos_out.get(p)),c);
+
+			expected++;
+		}
+	}
+
+	// modify the sorted properties and scatter back only the property 0
+
+	for (size_t i = 0 ; i < prp_out.size() ; i++)
+	{
+		prp_out.template get<0>(i) += 1.0;
+		prp_out.template get<2>(i) = 0;
+	}
+
+	rd.template scatter<0>(prp_out,prp);
+
+	for (size_t i = 0 ; i < prp.size() ; i++)
+	{
+		BOOST_REQUIRE_EQUAL(prp.template get<0>(i),i + 1.0);
+		BOOST_REQUIRE_EQUAL(prp.template get<2>(i),2*i);
+	}
+
+	// update() after the reorder work on the sorted ids
+
+	for (size_t i = 0 ; i < pos_out.size() ; i += 10)
+	{
+		for (size_t j = 0 ; j < 3 ; j++)
+		{pos_out.template get<0>(i)[j] = ud(eg);}
+	}
+
+	BOOST_REQUIRE(cl.update(pos_out) != pos_out.size());
+
+	CellList<3,float,Mem_fast<>> cl_ref(box,div);
+	cl_ref.fill(pos_out,pos_out.size());
+
+	Test_cell_same_content(cl,cl_ref);
+}
+
+/*! \brief Test the reordering of a symmetric cell-list with ghost particles
+ *
+ * The domain particles must stay before the ghost particles, so that update() after the
+ * reorder use the marker of fill()
+ *
+ */
+void Test_cell_reorder_sym()
+{
+	SpaceBox<3,float> box({0.0f,0.0f,0.0f},{1.0f,1.0f,1.0f});
+	size_t div[3] = {8,8,8};
+
+	size_t n_dom = 5000;
+	size_t n_ghost = 2000;
+
+	openfpm::vector<Point<3,float>> pos;
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<float> ud(0.0,1.0);
+	std::uniform_real_distribution<float> ug(-0.1,1.1);
+
+	for (size_t i = 0 ; i < n_dom ; i++)
+	{
+		pos.add();
+		for (size_t j = 0 ; j < 3 ; j++)
+		{pos.template get<0>(i)[j] = ud(eg);}
+	}
+
+	// ghost particles are in the padding cells outside the domain
+
+	while (pos.size() < n_dom + n_ghost)
+	{
+		Point<3,float> p({ug(eg),ug(eg),ug(eg)});
+		if (box.isInside(p) == true)	{continue;}
+
+		pos.add(p);
+	}
+
+	CellList<3,float,Mem_fast<>> cl(box,div);
+	cl.fill(pos,n_dom,CL_SYMMETRIC);
+
+	CellList_cpu_reorder<decltype(cl)> rd;
+	rd.construct(cl);
+
+	openfpm::vector<Point<3,float>> pos_out;
+	rd.reorder(pos,pos_out);
+
+	auto & s2ns = rd.getSortToNonSort();
+
+	for (size_t i = 0 ; i < pos_out.size() ; i++)
+	{BOOST_REQUIRE_EQUAL(s2ns.get(i) < n_dom,i < n_dom);}
+
+	// nothing moved
+
+	BOOST_REQUIRE_EQUAL(cl.update(pos_out),0ul);
+
+	// move some domain particles inside the domain
+
+	for (size_t i = 0 ; i < n_dom ; i += 10)
+	{
+		for (size_t j = 0 ; j < 3 ; j++)
+		{pos_out.template get<0>(i)[j] = ud(eg);}
+	}
+
+	BOOST_REQUIRE(cl.update(pos_out) != pos_out.size());
+
+	CellList<3,float,Mem_fast<>> cl_ref(box,div);
+	cl_ref.fill(pos_out,n_dom,CL_SYMMETRIC);
+
+	Test_cell_same_content(cl,cl_ref);
+}
+
 template<typename CellList> void Test_CellDecomposer_consistent()
 {
 	Box<2,float> bx({-1.0/3.0,-1.0/3.0},{1.0/3.0,1.0/3.0});
@@ -488,6 +1272,93 @@ template<unsigned int dim, typename T, typename CellS> void Test_NN_iterator_rad
 	BOOST_REQUIRE(number_of_nn2 < number_of_nn);
 }
 
+/*! \brief Test the periodic neighborhood iterator against brute force on the periodic images
+ *
+ * \tparam CellS type of cell-list
+ *
+ * \param bc boundary conditions
+ *
+ */
+template<typename CellS> void Test_cell_periodic(const size_t (& bc)[3])
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {10,8,12};
+	double r_cut = 0.08;
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<double> ud(0.0,1.0);
+
+	openfpm::vector<Point<3,double>> pos;
+	for (size_t i = 0 ; i < 3000 ; i++)
+	{pos.add(Point<3,double>({ud(eg),ud(eg),ud(eg)}));}
+
+	// no padding, no ghost particles
+
+	CellS cl(box,div,0);
+	cl.setPeriodic(bc);
+	cl.fill(pos,pos.size());
+
+	bool ret = true;
+
+	for (size_t p = 0 ; p < pos.size() ; p++)
+	{
+		Point<3,double> xp = pos.get(p);
+
+		openfpm::vector<size_t> nn_it;
+
+		auto NN = cl.getNNIteratorPeriodic(cl.getCell(xp));
+
+		while (NN.isNext())
+		{
+			size_t q = NN.get();
+			Point<3,double> xq = pos.get(q);
+			xq += NN.getShift();
+
+			if (xp.distance2(xq) < r_cut*r_cut)	{nn_it.add(q);}
+
+			++NN;
+		}
+
+		// brute force on the periodic images
+
+		openfpm::vector<size_t> nn_bf;
+
+		for (size_t q = 0 ; q < pos.size() ; q++)
+		{
+			for (size_t k = 0 ; k < 27 ; k++)
+			{
+				Point<3,double> xq = pos.get(q);
+				bool valid = true;
+
+				for (size_t d = 0, kd = k ; d < 3 ; d++, kd /= 3)
+				{
+					long int w = (long int)(kd % 3) - 1;
+					valid &= (w == 0 || bc[d] == PERIODIC);
+					xq.get(d) += w;
+				}
+
+				if (valid == true && xp.distance2(xq) < r_cut*r_cut)	{nn_bf.add(q);}
+			}
+		}
+
+		nn_it.sort();
+		nn_bf.sort();
+
+		ret &= (nn_it.size() == nn_bf.size());
+		for (size_t j = 0 ; j < nn_it.size() && j < nn_bf.size() ; j++)
+		{ret &= (nn_it.get(j) == nn_bf.get(j));}
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+
+	// the boundary conditions and the shifts survive the copy
+
+	CellS cl2 = cl;
+	BOOST_REQUIRE_EQUAL(cl2.getBC(0),bc[0]);
+	BOOST_REQUIRE_EQUAL(cl2.getPeriodicShift(2).get(0),1.0);
+	BOOST_REQUIRE_EQUAL(cl2.getPeriodicShift(0).get(2),-1.0);
+}
+
 BOOST_AUTO_TEST_SUITE( CellList_test )
 
 BOOST_AUTO_TEST_CASE ( NN_radius_check )
@@ -519,12 +1390,90 @@ BOOST_AUTO_TEST_CASE( CellList_use)
 
 	Test_cell_s<3,double,CellList<3,double,Mem_bal<>>>(box);
 	Test_cell_s<3,double,CellList<3,double,Mem_mw<>>>(box);
+	Test_cell_s<3,double,CellList<3,double,Mem_compact<>>>(box);
 
 	std::cout << "End cell list" << "\n";
 
 	// Test the cell list
 }
 
+BOOST_AUTO_TEST_CASE( CellList_fill )
+{
+	SpaceBox<3,double> box({0.0f,0.0f,0.0f},{1.0f,1.0f,1.0f});
+
+	Test_cell_fill<3,double,CellList<3,double,Mem_fast<>>>(box);
+	Test_cell_fill<3,double,CellList<3,double,Mem_fast<HeapMemory,unsigned int>>>(box);
+	Test_cell_fill<3,double,CellList<3,double,Mem_bal<>>>(box);
+	Test_cell_fill<3,double,CellList<3,double,Mem_compact<>>>(box);
+}
+
+BOOST_AUTO_TEST_CASE( CellList_knn )
+{
+	Test_cell_knn<CellList<3,double,Mem_fast<>>>();
+	Test_cell_knn<CellList<3,double,Mem_compact<>>>();
+}
+
+BOOST_AUTO_TEST_CASE( CellList_range_query_batch )
+{
+	Test_cell_range_batch<CellList<3,double,Mem_fast<>>>();
+	Test_cell_range_batch<CellList<3,double,Mem_bal<>>>();
+	Test_cell_range_batch<CellList<3,double,Mem_compact<>>>();
+}
+
+// in SE_CLASS1 the cell list consider the symmetric iterator on a non symmetric
+// construction as an hack, disable the test
+
+#ifndef SE_CLASS1
+
+BOOST_AUTO_TEST_CASE( CellList_sym_parallel_test )
+{
+	Test_cell_sym_parallel<CellList<3,double,Mem_fast<>>>();
+	Test_cell_sym_parallel<CellList<3,double,Mem_compact<>>>();
+}
+
+#endif
+
+BOOST_AUTO_TEST_CASE( CellList_update )
+{
+	SpaceBox<3,double> box({0.0f,0.0f,0.0f},{1.0f,1.0f,1.0f});
+
+	Test_cell_update<3,double,CellList<3,double,Mem_fast<>>>(box);
+	Test_cell_update<3,double,CellList<3,double,Mem_bal<>>>(box);
+	Test_cell_update<3,double,CellList<3,double,Mem_mw<>>>(box);
+	Test_cell_update<3,double,CellList<3,double,Mem_compact<>>>(box);
+}
+
+BOOST_AUTO_TEST_CASE( CellList_cell_order )
+{
+	typedef no_transform<3,double> nt;
+	typedef openfpm::vector<Point<3,double>> vp;
+
+	Test_cell_order<CellList<3,double,Mem_fast<>>,CellList<3,double,Mem_fast<>,nt,vp,CL_CELL_ORDER_MORTON>>(CL_CELL_ORDER_MORTON);
+	Test_cell_order<CellList<3,double,Mem_bal<>>,CellList<3,double,Mem_bal<>,nt,vp,CL_CELL_ORDER_MORTON>>(CL_CELL_ORDER_MORTON);
+	Test_cell_order<CellList<3,double,Mem_mw<>>,CellList<3,double,Mem_mw<>,nt,vp,CL_CELL_ORDER_MORTON>>(CL_CELL_ORDER_MORTON);
+	Test_cell_order<CellList<3,double,Mem_compact<>>,CellList<3,double,Mem_compact<>,nt,vp,CL_CELL_ORDER_MORTON>>(CL_CELL_ORDER_MORTON);
+
+	Test_cell_order<CellList<3,double,Mem_fast<>>,CellList<3,double,Mem_fast<>,nt,vp,CL_CELL_ORDER_HILBERT>>(CL_CELL_ORDER_HILBERT);
+	Test_cell_order<CellList<3,double,Mem_compact<>>,CellList<3,double,Mem_compact<>,nt,vp,CL_CELL_ORDER_HILBERT>>(CL_CELL_ORDER_HILBERT);
+}
+
+BOOST_AUTO_TEST_CASE( CellList_periodic_NN )
+{
+	size_t bc[3] = {PERIODIC,PERIODIC,PERIODIC};
+	size_t bc2[3] = {PERIODIC,NON_PERIODIC,PERIODIC};
+
+	Test_cell_periodic<CellList<3,double,Mem_fast<>,shift<3,double>>>(bc);
+	Test_cell_periodic<CellList<3,double,Mem_fast<>,shift<3,double>>>(bc2);
+	Test_cell_periodic<CellList<3,double,Mem_compact<>,shift<3,double>>>(bc);
+}
+
+BOOST_AUTO_TEST_CASE( CellList_cpu_reorder_test )
+{
+	Test_cell_reorder<memory_traits_lin>();
+	Test_cell_reorder<memory_traits_inte>();
+	Test_cell_reorder_sym();
+}
+
 BOOST_AUTO_TEST_CASE( CellList_consistent )
 {
 	Test_CellDecomposer_consistent<CellList<2,float,Mem_fast<>,shift<2,float>>>();
@@ -52,12 +52,7 @@ struct populate_cell_list_no_sym_impl
 			   	   	   	   size_t g_m,
 			   	   	   	   cl_construct_opt optc)
 	{
-		cli.clear();
-
-		for (size_t i = 0; i < pos.size() ; i++)
-		{
-			cli.add(pos.get(i), i);
-		}
+		cli.fill(pos,g_m,CL_NON_SYMMETRIC);
 	}
 };
 
@@ -89,17 +84,7 @@ struct populate_cell_list_sym_impl
 			   	   	   	   CellList & cli,
 			   	   	   	   size_t g_m)
 	{
-		cli.clear();
-
-		for (size_t i = 0; i < g_m ; i++)
-		{
-			cli.addDom(pos.get(i), i);
-		}
-
-		for (size_t i = g_m; i < pos.size() ; i++)
-		{
-			cli.addPad(pos.get(i), i);
-		}
+		cli.fill(pos,g_m,CL_SYMMETRIC);
 	}
 };
 
@@ -0,0 +1,417 @@
+/*
+ * CellNNBatch.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_CELLLIST_CELLNNBATCH_HPP_
+#define OPENFPM_DATA_SRC_NN_CELLLIST_CELLNNBATCH_HPP_
+
+#if !defined(__NVCC__) || defined(CUDA_ON_CPU)
+#include <Vc/Vc>
+#define CELL_NN_BATCH_VC
+#endif
+#include "NN/CellList/CellList.hpp"
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+/*! \brief Select the candidates closer than the cut-off radius, scalar implementation
+ *
+ * \tparam T type of space
+ * \tparam vc true when a Vc vector exist for T
+ *
+ */
+template<typename T, bool vc>
+struct nn_batch_filter_impl
+{
+	//! Number of candidates processed together (the packed buffers are padded to a multiple of it)
+	static const size_t width = 1;
+
+	/*! \brief Select the candidates closer than the cut-off radius
+	 *
+	 * \param x SoA positions of the candidates x[d][i]
+	 * \param xp point
+	 * \param n number of candidates
+	 * \param r_cut2 square of the cut-off radius
+	 * \param sel selected candidates (output, at least n elements)
+	 *
+	 * \return the number of selected candidates
+	 *
+	 */
+	template<unsigned int dim>
+	static inline size_t filter(const T * (& x)[dim], const T (& xp)[dim], size_t n, T r_cut2, unsigned int * sel)
+	{
+		size_t ns = 0;
+
+		for (size_t i = 0 ; i < n ; i++)
+		{
+			T d2 = 0;
+			for (size_t d = 0 ; d < dim ; d++)
+			{
+				T dx = x[d][i] - xp[d];
+				d2 += dx*dx;
+			}
+
+			// branch-less compression
+			sel[ns] = i;
+			ns += (d2 < r_cut2)?1:0;
+		}
+
+		return ns;
+	}
+};
+
+#ifdef CELL_NN_BATCH_VC
+
+/*! \brief Select the candidates closer than the cut-off radius, Vc implementation
+ *
+ * \tparam T type of space (float or double)
+ *
+ */
+template<typename T>
+struct nn_batch_filter_impl<T,true>
+{
+	//! Vc vector
+	typedef Vc::Vector<T> vT;
+
+	//! Number of candidates processed together (the packed buffers are padded to a multiple of it)
+	static const size_t width = vT::Size;
+
+	/*! \brief Select the candidates closer than the cut-off radius
+	 *
+	 * \param x SoA positions of the candidates x[d][i] padded to a multiple of width
+	 * \param xp point
+	 * \param n number of candidates
+	 * \param r_cut2 square of the cut-off radius
+	 * \param sel selected candidates (output, at least n elements)
+	 *
+	 * \return the number of selected candidates
+	 *
+	 */
+	template<unsigned int dim>
+	static inline size_t filter(const T * (& x)[dim], const T (& xp)[dim], size_t n, T r_cut2, unsigned int * sel)
+	{
+		size_t ns = 0;
+
+		vT vp[dim];
+		for (size_t d = 0 ; d < dim ; d++)
+		{vp[d] = vT(xp[d]);}
+
+		vT vr2(r_cut2);
+
+		for (size_t i = 0 ; i < n ; i += width)
+		{
+			vT d2(Vc::Zero);
+			for (size_t d = 0 ; d < dim ; d++)
+			{
+				vT dx = vT(&x[d][i],Vc::Unaligned) - vp[d];
+				d2 += dx*dx;
+			}
+
+			// compress the mask into the list of the selected candidates
+
+			unsigned int m = (d2 < vr2).toInt();
+			while (m != 0)
+			{
+				sel[ns] = i + __builtin_ctz(m);
+				ns++;
+				m &= m - 1;
+			}
+		}
+
+		return ns;
+	}
+};
+
+#endif
+
+/*! \brief Batched neighborhood traversal of a Cell-list
+ *
+ * Instead of visiting the neighborhood one particle at a time (getNNIterator), the ids and the
+ * positions of all the particles in the neighborhood cells of a cell are packed once into
+ * contiguous SoA buffers. For every particle of the cell the squared distances to all the
+ * candidates are then computed with SIMD instructions (Vc, scalar fallback for types that
+ * Vc does not support) and only the candidates inside the cut-off radius are returned
+ * as a compressed list
+ *
+ * \tparam CellList_type type of Cell-list
+ * \tparam vector_pos_type type of the position vector
+ *
+ * ### Example
+ *
+ * \code
+ * CellNNBatch<decltype(cl),decltype(pos)> nnb(cl,pos);
+ *
+ * nnb.loadCell(c);
+ * for (size_t j = 0 ; j < cl.getNelements(c) ; j++)
+ * {
+ *     size_t p = cl.get(c,j);
+ *     size_t n = nnb.filter(p,r_cut*r_cut);
+ *
+ *     for (size_t k = 0 ; k < n ; k++)
+ *     {
+ *         size_t q = nnb.getNN(k);
+ *         // ... (q == p is included)
+ *     }
+ * }
+ * \endcode
+ *
+ */
+template<typename CellList_type, typename vector_pos_type>
+class CellNNBatch
+{
+	//! type of space
+	typedef typename CellList_type::stype T;
+
+	//! dimensionality
+	static const unsigned int dim = CellList_type::dims;
+
+	//! implementation of the distance filter
+	typedef nn_batch_filter_impl<T,std::is_same<T,float>::value || std::is_same<T,double>::value> filter_impl;
+
+	//! Cell-list
+	CellList_type & cl;
+
+	//! positions
+	const vector_pos_type & pos;
+
+	//! ids of the candidates
+	openfpm::vector<aggregate<typename CellList_type::value_type>> cand;
+
+	//! SoA positions of the candidates
+	openfpm::vector<aggregate<T>> x[dim];
+
+	//! selected candidates (index in cand)
+	openfpm::vector<aggregate<unsigned int>> sel;
+
+	//! number of candidates
+	size_t n_cand = 0;
+
+	//! candidates of the center cell [0,n_center) (symmetric traversal)
+	size_t n_center = 0;
+
+	//! option of the traversal
+	size_t opt = CL_NON_SYMMETRIC;
+
+	/*! \brief Check the symmetric condition on a candidate of the center cell
+	 *
+	 * Same condition used by CellNNIteratorSym
+	 *
+	 * \param p particle
+	 * \param q candidate
+	 *
+	 * \return true if the pair p,q is visited from p
+	 *
+	 */
+	inline bool sym_valid(size_t p, size_t q) const
+	{
+		for (long int i = dim-1 ; i >= 0 ; i--)
+		{
+			if (pos.template get<0>(p)[i] < pos.template get<0>(q)[i])
+			{return true;}
+			else if (pos.template get<0>(p)[i] > pos.template get<0>(q)[i])
+			{return false;}
+		}
+
+		return q >= p;
+	}
+
+	/*! \brief Add the particles of one cell to the candidates
+	 *
+	 * \param c cell
+	 *
+	 */
+	inline void pack_cell(long int c)
+	{
+		if (c < 0 || c >= (long int)cl.getNCells())	{return;}
+
+		size_t n_ele = cl.getNelements(c);
+
+		for (size_t j = 0 ; j < n_ele ; j++, n_cand++)
+		{
+			auto q = cl.get(c,j);
+			cand.template get<0>(n_cand) = q;
+
+			for (size_t d = 0 ; d < dim ; d++)
+			{x[d].template get<0>(n_cand) = pos.template get<0>(q)[d];}
+		}
+	}
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param cl Cell-list
+	 * \param pos positions of the particles stored in the Cell-list
+	 *
+	 */
+	CellNNBatch(CellList_type & cl, const vector_pos_type & pos)
+	:cl(cl),pos(pos)
+	{}
+
+	/*! \brief Pack the candidates of the neighborhood of a cell
+	 *
+	 * \param cell cell
+	 * \param opt CL_NON_SYMMETRIC the full neighborhood, CL_SYMMETRIC the half
+	 *        neighborhood (as getNNIteratorSym)
+	 *
+	 */
+	void loadCell(size_t cell, size_t opt = CL_NON_SYMMETRIC)
+	{
+		this->opt = opt;
+
+		// upper bound on the number of candidates
+
+		size_t n_max = 0;
+		if (opt == CL_SYMMETRIC)
+		{
+			const auto & NNc = cl.getNNc_sym();
+			for (size_t n = 0 ; n < openfpm::math::pow(3,dim)/2+1 ; n++)
+			{
+				long int c = cell + NNc[n];
+				if (c >= 0 && c < (long int)cl.getNCells())	{n_max += cl.getNelements(c);}
+			}
+		}
+		else
+		{
+			const auto & NNc = cl.private_get_NNc_full();
+			for (size_t n = 0 ; n < openfpm::math::pow(3,dim) ; n++)
+			{
+				long int c = cell + NNc[n];
+				if (c >= 0 && c < (long int)cl.getNCells())	{n_max += cl.getNelements(c);}
+			}
+		}
+
+		size_t n_pad = (n_max + filter_impl::width - 1) / filter_impl::width * filter_impl::width;
+
+		cand.resize(n_pad);
+		sel.resize(n_pad);
+		for (size_t d = 0 ; d < dim ; d++)
+		{x[d].resize(n_pad);}
+
+		// the center cell go first so that the symmetric condition
+		// can be checked only on the first n_center candidates
+
+		n_cand = 0;
+		pack_cell(cell);
+		n_center = n_cand;
+
+		if (opt == CL_SYMMETRIC)
+		{
+			const auto & NNc = cl.getNNc_sym();
+			for (size_t n = 0 ; n < openfpm::math::pow(3,dim)/2+1 ; n++)
+			{
+				if (NNc[n] != 0)	{pack_cell(cell + NNc[n]);}
+			}
+		}
+		else
+		{
+			const auto & NNc = cl.private_get_NNc_full();
+			for (size_t n = 0 ; n < openfpm::math::pow(3,dim) ; n++)
+			{
+				if (NNc[n] != 0)	{pack_cell(cell + NNc[n]);}
+			}
+		}
+
+		// padding, far away from any particle
+
+		T far = std::sqrt(std::numeric_limits<T>::max()) / 4;
+		for (size_t i = n_cand ; i < n_pad ; i++)
+		{
+			cand.template get<0>(i) = 0;
+			for (size_t d = 0 ; d < dim ; d++)
+			{x[d].template get<0>(i) = far;}
+		}
+	}
+
+	/*! \brief Select the candidates closer than the cut-off radius from a point
+	 *
+	 * The neighborhood is the full one, the symmetric option is ignored
+	 *
+	 * \param xp point
+	 * \param r_cut2 square of the cut-off radius
+	 *
+	 * \return the number of neighborhood particles
+	 *
+	 */
+	size_t filter(const Point<dim,T> & xp, T r_cut2)
+	{
+		if (n_cand == 0)	{return 0;}
+
+		const T * xs[dim];
+		T xa[dim];
+		for (size_t d = 0 ; d < dim ; d++)
+		{
+			xs[d] = &x[d].template get<0>(0);
+			xa[d] = xp.get(d);
+		}
+
+		return filter_impl::template filter<dim>(xs,xa,n_cand,r_cut2,&sel.template get<0>(0));
+	}
+
+	/*! \brief Select the candidates closer than the cut-off radius from a particle of the cell
+	 *
+	 * The particle itself is included (as with getNNIterator). With the symmetric option
+	 * only the neighborhood particles that getNNIteratorSym would return are selected
+	 *
+	 * \param p particle
+	 * \param r_cut2 square of the cut-off radius
+	 *
+	 * \return the number of neighborhood particles
+	 *
+	 */
+	size_t filter(size_t p, T r_cut2)
+	{
+		Point<dim,T> xp = pos.template get<0>(p);
+
+		size_t ns = filter(xp,r_cut2);
+
+		if (opt == CL_SYMMETRIC)
+		{
+			// the selected candidates are in increasing order, the candidates of the
+			// center cell are first
+
+			size_t k = 0;
+			size_t nv = 0;
+			for ( ; k < ns && sel.template get<0>(k) < n_center ; k++)
+			{
+				unsigned int s = sel.template get<0>(k);
+				sel.template get<0>(nv) = s;
+				nv += sym_valid(p,cand.template get<0>(s))?1:0;
+			}
+
+			for ( ; k < ns ; k++, nv++)
+			{sel.template get<0>(nv) = sel.template get<0>(k);}
+
+			ns = nv;
+		}
+
+		return ns;
+	}
+
+	/*! \brief Return the neighborhood particle k selected by the last filter
+	 *
+	 * \param k index
+	 *
+	 * \return the particle id
+	 *
+	 */
+	inline auto getNN(size_t k) const -> decltype(cand.template get<0>(0))
+	{
+		return cand.template get<0>(sel.template get<0>(k));
+	}
+
+	/*! \brief Return the number of candidates of the loaded cell
+	 *
+	 * \return the number of candidates
+	 *
+	 */
+	inline size_t getNCandidates() const
+	{
+		return n_cand;
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLNNBATCH_HPP_ */
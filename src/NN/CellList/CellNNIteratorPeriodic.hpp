@@ -0,0 +1,173 @@
+/*
+ * CellNNIteratorPeriodic.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_CELLLIST_CELLNNITERATORPERIODIC_HPP_
+#define OPENFPM_DATA_SRC_NN_CELLLIST_CELLNNITERATORPERIODIC_HPP_
+
+#include "util/mathutil.hpp"
+#include "Space/Shape/Point.hpp"
+
+/*! \brief Iterator for the neighborhood of a cell of a periodic Cell-list
+ *
+ * In general you never create it directly but you get it from the CellList structures
+ * (getNNIteratorPeriodic)
+ *
+ * It iterate across all the element of the selected cell and the near cells. On the
+ * periodic dimensions the near cells beyond the domain are taken from the other side of
+ * the domain, getShift() return the shift to add to the position of the actual element to
+ * get its periodic image near the selected cell. No ghost particles are needed
+ *
+ * \tparam dim dimensionality of the space where the cell live
+ * \tparam Cell cell type on which the iterator is working
+ *
+ */
+template<unsigned int dim, typename Cell>
+class CellNNIteratorPeriodic
+{
+	//! neighborhood size
+	static const unsigned int NNc_size = openfpm::math::pow(3,dim);
+
+	//! actual element id
+	const typename Cell::Mem_type_type::local_index_type * start_id;
+
+	//! stop id to read the end of the cell
+	const typename Cell::Mem_type_type::local_index_type * stop_id;
+
+	//! Actual NNc_id;
+	size_t NNc_id;
+
+	//! number of neighborhood cells
+	size_t n_nnc;
+
+	//! neighborhood cells
+	size_t NNc[NNc_size];
+
+	//! shift of every neighborhood cell (index in the shift table of the Cell-list)
+	unsigned char NNs[NNc_size];
+
+	//! Cell list
+	Cell & cl;
+
+	/*! \brief Select non-empty cell
+	 *
+	 */
+	__attribute__((always_inline)) inline void selectValid()
+	{
+		while (start_id == stop_id)
+		{
+			NNc_id++;
+
+			// No more Cell
+			if (NNc_id >= n_nnc) return;
+
+			start_id = &cl.getStartId(NNc[NNc_id]);
+			stop_id = &cl.getStopId(NNc[NNc_id]);
+		}
+	}
+
+public:
+
+	/*! \brief Cell NN iterator
+	 *
+	 * \param cell Cell id
+	 * \param cl Cell structure
+	 *
+	 */
+	CellNNIteratorPeriodic(size_t cell, Cell & cl)
+	:NNc_id(0),n_nnc(0),cl(cl)
+	{
+		const grid_sm<dim,void> & gr = cl.getInternalGrid();
+		grid_key_dx<dim> gc = gr.InvLinId(cell);
+
+		for (size_t n = 0 ; n < NNc_size ; n++)
+		{
+			grid_key_dx<dim> key;
+			size_t s = 0;
+			size_t mul = 1;
+			bool valid = true;
+
+			for (size_t d = 0, nd = n ; d < dim ; d++, nd /= 3, mul *= 3)
+			{
+				long int c = gc.get(d) + (long int)(nd % 3) - 1;
+				long int lo = cl.getPadding(d);
+				long int div = gr.size(d) - 2*cl.getPadding(d);
+				long int w = 0;
+
+				if (cl.getBC(d) == PERIODIC)
+				{
+					if (c < lo)
+					{c += div; w = -1;}
+					else if (c >= lo + div)
+					{c -= div; w = 1;}
+				}
+
+				valid &= (c >= 0 && c < (long int)gr.size(d));
+
+				key.set_d(d,c);
+				s += (w + 1) * mul;
+			}
+
+			if (valid == false)	{continue;}
+
+			NNc[n_nnc] = gr.LinId(key);
+			NNs[n_nnc] = s;
+			n_nnc++;
+		}
+
+		start_id = &cl.getStartId(NNc[0]);
+		stop_id = &cl.getStopId(NNc[0]);
+		selectValid();
+	}
+
+	/*! \brief Check if there is the next element
+	 *
+	 * \return true if there is the next element
+	 *
+	 */
+	__attribute__((always_inline)) inline bool isNext()
+	{
+		if (NNc_id >= n_nnc)
+			return false;
+		return true;
+	}
+
+	/*! \brief take the next element
+	 *
+	 * \return itself
+	 *
+	 */
+	__attribute__((always_inline)) inline CellNNIteratorPeriodic & operator++()
+	{
+		start_id++;
+
+		selectValid();
+
+		return *this;
+	}
+
+	/*! \brief Get the value of the cell
+	 *
+	 * \return  the next element object
+	 *
+	 */
+	__attribute__((always_inline)) inline const typename Cell::Mem_type_type::local_index_type & get() const
+	{
+		return cl.get_lin(start_id);
+	}
+
+	/*! \brief Get the shift to apply to the position of the actual element
+	 *
+	 * \return the shift (zero if the element is not taken across a periodic boundary)
+	 *
+	 */
+	__attribute__((always_inline)) inline const Point<dim,typename Cell::stype> & getShift() const
+	{
+		return cl.getPeriodicShift(NNs[NNc_id]);
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLNNITERATORPERIODIC_HPP_ */
@@ -8,10 +8,8 @@
 #ifndef OPENFPM_DATA_SRC_NN_CELLLIST_PROCKEYS_HPP_
 #define OPENFPM_DATA_SRC_NN_CELLLIST_PROCKEYS_HPP_
 
-extern "C"
-{
-#include "hilbertKey.h"
-}
+#include "util/hilbert.hpp"
+#include "util/cpu_parallel_util.hpp"
 
 /* !Brief Class for a linear (1D-like) order processing of cell keys for CellList_gen implementation
  *
@@ -58,6 +56,32 @@ public:
 		keys.add(obj.getGrid().LinIdPtr(static_cast<size_t *>(point)));
 	}
 
+	/*! \brief Calculate the keys of all the cells of a grid
+	 *
+	 * Same keys as calling get_hkey for every cell in linear order, calculated in parallel
+	 *
+	 * \tparam S Cell list type
+	 *
+	 * \param obj Cell list object
+	 * \param gs grid of the cells (without padding)
+	 * \param m order of a curve
+	 */
+	template<typename S> void get_hkeys(S & obj, const grid_sm<dim,void> & gs, size_t m)
+	{
+		keys.resize(gs.size());
+
+		#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(gs.size())) schedule(static)
+		for (size_t i = 0 ; i < gs.size() ; i++)
+		{
+			grid_key_dx<dim> gk = gs.InvLinId(i);
+
+			size_t point[dim];
+			for (size_t j = 0 ; j < dim ; j++)	{point[j] = gk.get(j) + obj.getPadding(j);}
+
+			keys.get(i) = obj.getGrid().LinIdPtr(static_cast<size_t *>(point));
+		}
+	}
+
 	template<typename S> void linearize_hkeys(S & obj, size_t m)
 	{
 		return;
@@ -105,19 +129,26 @@ public:
 	 */
 	template<typename S> inline void get_hkey(S & obj, grid_key_dx<dim> gk, size_t m)
 	{
-		//An integer to handle errors
-		int err;
-
-		uint64_t point[dim];
-
-		for (size_t i = 0; i < dim; i++)
-		{
-			point[i] = gk.get(i);
-		}
+		keys.add(lin_hid(gk,m));
+	}
 
-		size_t hkey = getHKeyFromIntCoord(m, dim, point, &err);
+	/*! \brief Calculate the hilbert keys of all the cells of a grid
+	 *
+	 * Same keys as calling get_hkey for every cell in linear order, calculated in parallel
+	 *
+	 * \tparam S Cell list type
+	 *
+	 * \param obj Cell list object
+	 * \param gs grid of the cells (without padding)
+	 * \param m order of a curve
+	 */
+	template<typename S> void get_hkeys(S & obj, const grid_sm<dim,void> & gs, size_t m)
+	{
+		keys.resize(gs.size());
 
-		keys.add(hkey);
+		#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(gs.size())) schedule(static)
+		for (size_t i = 0 ; i < gs.size() ; i++)
+		{keys.get(i) = lin_hid(gs.InvLinId(i),m);}
 	}
 
 	/*! \brief Get get the coordinates from hilbert key, linearize and add to the getKeys vector
@@ -129,24 +160,21 @@ public:
 	 */
 	template<typename S> inline void linearize_hkeys(S & obj, size_t m)
 	{
-		//An integer to handle errors
-		int err;
-
-		//Array to handle output
-		uint64_t coord[dim];
-		size_t coord2[dim];
-
 		keys.sort();
 
-		openfpm::vector<size_t> keys_new;
+		openfpm::vector<size_t> keys_new(keys.size());
+
+		// decode the keys in parallel
 
-		for(size_t i = 0; i < obj.getKeys().size(); i++)
+		#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(keys.size())) schedule(static)
+		for (size_t i = 0 ; i < keys.size() ; i++)
 		{
-			getIntCoordFromHKey(coord, m, dim, obj.getKeys().get(i), &err);
+			size_t coord[dim];
+			hilbert_point<dim>(keys.get(i),m,coord);
 
-			for (size_t j = 0 ; j < dim ; j++)	{coord2[j] = coord[j] + obj.getPadding(j);}
+			for (size_t j = 0 ; j < dim ; j++)	{coord[j] += obj.getPadding(j);}
 
-			keys_new.add(obj.getGrid().LinIdPtr(static_cast<size_t *>(coord2)));
+			keys_new.get(i) = obj.getGrid().LinIdPtr(static_cast<size_t *>(coord));
 		}
 
 		keys.swap(keys_new);
@@ -206,6 +234,25 @@ public:
 		keys.add(hkey);
 	}
 
+	/*! \brief Calculate the keys of all the cells of a grid
+	 *
+	 * Same keys as calling get_hkey for every cell in linear order, calculated in parallel
+	 *
+	 * \tparam S Cell list type
+	 *
+	 * \param obj Cell list object
+	 * \param gs grid of the cells (without padding)
+	 * \param m order of a curve
+	 */
+	template<typename S> void get_hkeys(S & obj, const grid_sm<dim,void> & gs, size_t m)
+	{
+		keys.resize(gs.size());
+
+		#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(gs.size())) schedule(static)
+		for (size_t i = 0 ; i < gs.size() ; i++)
+		{keys.get(i) = obj.getGrid().LinId(gs.InvLinId(i));}
+	}
+
 	/*! \brief Get get the coordinates from hilbert key, linearize and add to the getKeys vector
 	 *
 	 * \tparam S Cell list type
@@ -0,0 +1,200 @@
+/*
+ * CellList_performance_tests.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_CELLLIST_PERFORMANCE_CELLLIST_PERFORMANCE_TESTS_HPP_
+#define OPENFPM_DATA_SRC_NN_CELLLIST_PERFORMANCE_CELLLIST_PERFORMANCE_TESTS_HPP_
+
+#include "NN/CellList/CellList.hpp"
+#include "util/stat/common_statistics.hpp"
+
+// Property tree
+struct report_cell_list_func_tests
+{
+	boost::property_tree::ptree graphs;
+};
+
+report_cell_list_func_tests report_cl_funcs;
+
+BOOST_AUTO_TEST_SUITE( cell_list_performance )
+
+/*! \brief Measure the incremental update of a cell-list against a full fill
+ *
+ * \param fr one particle every fr is moved to a random position
+ * \param k id of the test in the report
+ *
+ */
+template<typename CellS>
+void cell_list_update_vs_fill(size_t fr, size_t k)
+{
+	SpaceBox<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {64,64,64};
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<double> ud(0.0,1.0);
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < 2000000 ; i++)
+	{pos.add(Point<3,double>({ud(eg),ud(eg),ud(eg)}));}
+
+	std::vector<double> times_fill(N_STAT_SMALL + 1);
+	std::vector<double> times_up(N_STAT_SMALL + 1);
+
+	CellS cl_fill(box,div);
+	CellS cl_up(box,div);
+	cl_up.fill(pos,pos.size());
+
+	for (size_t i = 0 ; i < N_STAT_SMALL+1 ; i++)
+	{
+		for (size_t p = i % fr ; p < pos.size() ; p += fr)
+		{
+			for (size_t j = 0 ; j < 3 ; j++)
+			{pos.template get<0>(p)[j] = ud(eg);}
+		}
+
+		timer t;
+		t.start();
+
+		cl_fill.fill(pos,pos.size());
+
+		t.stop();
+		times_fill[i] = t.getwct();
+
+		timer tu;
+		tu.start();
+
+		cl_up.update(pos);
+
+		tu.stop();
+		times_up[i] = tu.getwct();
+	}
+
+	double mean;
+	double dev;
+
+	std::string base = "performance.cell_list.update(" + std::to_string(k) + ")";
+
+	report_cl_funcs.graphs.put(base + ".movers",100 / fr);
+
+	standard_deviation(times_fill,mean,dev);
+	report_cl_funcs.graphs.put(base + ".fill.data.mean",mean);
+	report_cl_funcs.graphs.put(base + ".fill.data.dev",dev);
+
+	std::cout << "Cell-list movers " << 100 / fr << "%  fill: " << mean << " +- " << dev;
+
+	standard_deviation(times_up,mean,dev);
+	report_cl_funcs.graphs.put(base + ".update.data.mean",mean);
+	report_cl_funcs.graphs.put(base + ".update.data.dev",dev);
+
+	std::cout << "  update: " << mean << " +- " << dev << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(cell_list_performance_update)
+{
+	// 1%, 10% and 50% of movers
+
+	cell_list_update_vs_fill<CellList<3,double,Mem_fast<>>>(100,0);
+	cell_list_update_vs_fill<CellList<3,double,Mem_fast<>>>(10,1);
+	cell_list_update_vs_fill<CellList<3,double,Mem_fast<>>>(2,2);
+}
+
+/*! \brief Measure fill and neighborhood traversal of a cell-list on a sparse domain
+ *
+ * Most of the cells are empty, the particles are in a thin slab
+ *
+ * \param name name of the memory type in the report
+ * \param k id of the test in the report
+ *
+ */
+template<typename CellS>
+void cell_list_sparse_mem_type(const std::string & name, size_t k)
+{
+	SpaceBox<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {100,100,100};
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<double> ud(0.0,1.0);
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < 200000 ; i++)
+	{pos.add(Point<3,double>({ud(eg),ud(eg),0.5 + 0.02*ud(eg)}));}
+
+	std::vector<double> times_fill(N_STAT_SMALL + 1);
+	std::vector<double> times_nn(N_STAT_SMALL + 1);
+
+	size_t tot = 0;
+
+	for (size_t i = 0 ; i < N_STAT_SMALL+1 ; i++)
+	{
+		CellS cl(box,div);
+
+		timer t;
+		t.start();
+
+		cl.fill(pos,pos.size());
+
+		t.stop();
+		times_fill[i] = t.getwct();
+
+		timer tn;
+		tn.start();
+
+		for (size_t p = 0 ; p < pos.size() ; p++)
+		{
+			Point<3,double> xp = pos.get(p);
+			auto NN = cl.template getNNIterator<NO_CHECK>(cl.getCell(xp));
+
+			while (NN.isNext())
+			{
+				tot += NN.get();
+				++NN;
+			}
+		}
+
+		tn.stop();
+		times_nn[i] = tn.getwct();
+	}
+
+	double mean;
+	double dev;
+
+	std::string base = "performance.cell_list.sparse(" + std::to_string(k) + ")";
+
+	report_cl_funcs.graphs.put(base + ".name",name);
+
+	standard_deviation(times_fill,mean,dev);
+	report_cl_funcs.graphs.put(base + ".fill.data.mean",mean);
+	report_cl_funcs.graphs.put(base + ".fill.data.dev",dev);
+
+	std::cout << "Cell-list sparse " << name << "  fill: " << mean << " +- " << dev;
+
+	standard_deviation(times_nn,mean,dev);
+	report_cl_funcs.graphs.put(base + ".nn.data.mean",mean);
+	report_cl_funcs.graphs.put(base + ".nn.data.dev",dev);
+
+	std::cout << "  NN traversal: " << mean << " +- " << dev << " (" << tot << ")" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(cell_list_performance_sparse)
+{
+	cell_list_sparse_mem_type<CellList<3,double,Mem_fast<>>>("Mem_fast",0);
+	cell_list_sparse_mem_type<CellList<3,double,Mem_bal<>>>("Mem_bal",1);
+	cell_list_sparse_mem_type<CellList<3,double,Mem_mw<>>>("Mem_mw",2);
+}
+
+/////// THIS IS NOT A TEST IT WRITE THE PERFORMANCE RESULT ///////
+
+BOOST_AUTO_TEST_CASE(cell_list_performance_write_report)
+{
+	boost::property_tree::xml_writer_settings<std::string> settings(' ', 4);
+	boost::property_tree::write_xml("cell_list_performance_funcs.xml", report_cl_funcs.graphs,std::locale(),settings);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* OPENFPM_DATA_SRC_NN_CELLLIST_PERFORMANCE_CELLLIST_PERFORMANCE_TESTS_HPP_ */
@@ -0,0 +1,191 @@
+/*
+ * CellListAdaptive_unit_tests.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include "NN/CellList/CellListAdaptive.hpp"
+
+BOOST_AUTO_TEST_SUITE( CellListAdaptive_test )
+
+/*! \brief Check a dense cluster in a dilute background against brute force
+ *
+ * \param n_bg number of particles of the background
+ * \param n_cl number of particles of the cluster
+ *
+ */
+void test_adaptive_clustered(size_t n_bg, size_t n_cl)
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {10,10,10};
+	double r_cut = 0.1;
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<double> ud(0.0,1.0);
+	std::normal_distribution<double> nd(0.0,0.01);
+
+	// a dense cluster in a dilute background
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < n_bg ; i++)
+	{pos.add(Point<3,double>({ud(eg),ud(eg),ud(eg)}));}
+
+	for (size_t i = 0 ; i < n_cl ; i++)
+	{
+		Point<3,double> p({0.42 + nd(eg),0.55 + nd(eg),0.5 + nd(eg)});
+
+		for (size_t d = 0 ; d < 3 ; d++)
+		{p.get(d) = (p.get(d) < 0.0)?0.0:((p.get(d) > 1.0)?1.0:p.get(d));}
+
+		pos.add(p);
+	}
+
+	size_t max_part = 16;
+	size_t max_level = 8;
+
+	CellListAdaptive<3,double> cl;
+	cl.Initialize(box,div,max_part,max_level);
+	cl.fill(pos,pos.size());
+
+	BOOST_REQUIRE(cl.getLevel() > 0);
+
+	// every particle is in exactly one leaf reached from the top level cells, the children
+	// split the particles of the parent and the leaves not at the maximum level are not overfull
+
+	openfpm::vector<size_t> seen(pos.size());
+	seen.fill(0);
+
+	bool ret = true;
+	size_t n_visit = 0;
+
+	std::vector<std::pair<size_t,size_t>> stack;
+	for (size_t c = 0 ; c < cl.getTopGrid().size() ; c++)
+	{stack.push_back(std::make_pair(c,(size_t)0));}
+
+	while (stack.size() != 0)
+	{
+		size_t n = stack.back().first;
+		size_t lev = stack.back().second;
+		stack.pop_back();
+
+		n_visit++;
+
+		const acl_node<3,double> & nn = cl.getNode(n);
+
+		if (nn.child == -1)
+		{
+			ret &= (lev >= max_level || nn.stop - nn.start <= max_part);
+
+			for (size_t i = nn.start ; i < nn.stop ; i++)
+			{seen.get(cl.getPart(i))++;}
+
+			continue;
+		}
+
+		ret &= ((size_t)nn.child + 8 <= cl.getNNodes());
+		ret &= (cl.getNode(nn.child).start == nn.start);
+		ret &= (cl.getNode(nn.child + 7).stop == nn.stop);
+
+		for (size_t c = 0 ; c < 8 ; c++)
+		{
+			if (c != 0)	{ret &= (cl.getNode(nn.child + c).start == cl.getNode(nn.child + c - 1).stop);}
+			stack.push_back(std::make_pair(nn.child + c,lev+1));
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+	BOOST_REQUIRE_EQUAL(n_visit,cl.getNNodes());
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{ret &= (seen.get(i) == 1);}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+
+	// neighborhood against brute force (dilute and dense particles)
+
+	size_t n_cand = 0;
+	size_t n_nn = 0;
+
+	for (size_t p = 0 ; p < pos.size() ; p += 7)
+	{
+		Point<3,double> xp = pos.get(p);
+
+		openfpm::vector<size_t> nn_it;
+
+		auto NN = cl.getNNIterator(xp,r_cut);
+		while (NN.isNext())
+		{
+			size_t q = NN.get();
+			if (xp.distance2(pos.get(q)) < r_cut*r_cut)	{nn_it.add(q);}
+
+			n_cand++;
+			++NN;
+		}
+
+		openfpm::vector<size_t> nn_bf;
+		for (size_t q = 0 ; q < pos.size() ; q++)
+		{
+			if (xp.distance2(pos.get(q)) < r_cut*r_cut)	{nn_bf.add(q);}
+		}
+
+		nn_it.sort();
+		nn_bf.sort();
+
+		ret &= (nn_it.size() == nn_bf.size());
+		for (size_t j = 0 ; j < nn_it.size() && j < nn_bf.size() ; j++)
+		{ret &= (nn_it.get(j) == nn_bf.get(j));}
+
+		n_nn += nn_bf.size();
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+	BOOST_REQUIRE(n_cand >= n_nn);
+
+	// a point outside the domain far from the particles
+
+	auto NN = cl.getNNIterator(Point<3,double>({3.0,3.0,3.0}),r_cut);
+	BOOST_REQUIRE_EQUAL(NN.isNext(),false);
+}
+
+BOOST_AUTO_TEST_CASE( CellListAdaptive_clustered )
+{
+	test_adaptive_clustered(1000,4000);
+}
+
+BOOST_AUTO_TEST_CASE( CellListAdaptive_clustered_threads )
+{
+	// with a small grain the top level cells are refined by several threads in
+	// private node buffers that are joined
+
+	size_t grain = openfpm::cpu_parallel_grain();
+	openfpm::cpu_parallel_grain() = 256;
+
+	test_adaptive_clustered(1000,4000);
+	test_adaptive_clustered(3000,20000);
+
+	openfpm::cpu_parallel_grain() = grain;
+}
+
+BOOST_AUTO_TEST_CASE( CellListAdaptive_empty )
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {4,4,4};
+
+	openfpm::vector<Point<3,double>> pos;
+
+	CellListAdaptive<3,double> cl;
+	cl.Initialize(box,div);
+	cl.fill(pos,0);
+
+	BOOST_REQUIRE_EQUAL(cl.getNNodes(),64ul);
+
+	auto NN = cl.getNNIterator(Point<3,double>({0.5,0.5,0.5}),0.3);
+	BOOST_REQUIRE_EQUAL(NN.isNext(),false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,145 @@
+/*
+ * CellNNBatch_unit_tests.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include "NN/CellList/CellNNBatch.hpp"
+
+BOOST_AUTO_TEST_SUITE( CellNNBatch_test )
+
+/*! \brief Return true if the distance of two particles is not ambiguous with respect to r_cut
+ *
+ * (SIMD and scalar distances can differ in the last bits)
+ *
+ */
+template<typename T>
+bool not_borderline(const Point<3,T> & xp, const Point<3,T> & xq, T r_cut)
+{
+	T d2 = xp.distance2(xq);
+	return std::fabs(d2 - r_cut*r_cut) > 1e-5*r_cut*r_cut;
+}
+
+template<typename T>
+void test_cell_nn_batch(size_t opt)
+{
+	Box<3,T> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {10,10,10};
+	T r_cut = 0.1;
+
+	std::default_random_engine eg(opt);
+	std::uniform_real_distribution<T> ud(0.0,1.0);
+
+	openfpm::vector<Point<3,T>> pos;
+
+	for (size_t i = 0 ; i < 5000 ; i++)
+	{pos.add(Point<3,T>({ud(eg),ud(eg),ud(eg)}));}
+
+	CellList<3,T,Mem_fast<>> cl;
+	cl.Initialize(box,div,1);
+	cl.fill(pos,pos.size());
+
+	CellNNBatch<decltype(cl),decltype(pos)> nnb(cl,pos);
+
+	// compare with the neighborhood iterators followed by the distance check
+
+	bool ret = true;
+	size_t tot = 0;
+
+	for (size_t c = 0 ; c < cl.getNCells() ; c++)
+	{
+		if (cl.getNelements(c) == 0)	{continue;}
+
+		nnb.loadCell(c,opt);
+
+		for (size_t j = 0 ; j < cl.getNelements(c) ; j++)
+		{
+			size_t p = cl.get(c,j);
+			Point<3,T> xp = pos.template get<0>(p);
+
+			openfpm::vector<size_t> nn_it;
+
+			if (opt == CL_SYMMETRIC)
+			{
+				auto NN = cl.template getNNIteratorSym<NO_CHECK>(c,p,pos);
+				while (NN.isNext())
+				{
+					size_t q = NN.get();
+					if (xp.distance2(pos.template get<0>(q)) < r_cut*r_cut && not_borderline<T>(xp,pos.template get<0>(q),r_cut))
+					{nn_it.add(q);}
+					++NN;
+				}
+			}
+			else
+			{
+				auto NN = cl.template getNNIterator<NO_CHECK>(c);
+				while (NN.isNext())
+				{
+					size_t q = NN.get();
+					if (xp.distance2(pos.template get<0>(q)) < r_cut*r_cut && not_borderline<T>(xp,pos.template get<0>(q),r_cut))
+					{nn_it.add(q);}
+					++NN;
+				}
+			}
+
+			size_t n = nnb.filter(p,r_cut*r_cut);
+
+			openfpm::vector<size_t> nn_bt;
+			for (size_t k = 0 ; k < n ; k++)
+			{
+				size_t q = nnb.getNN(k);
+				if (not_borderline<T>(xp,pos.template get<0>(q),r_cut))	{nn_bt.add(q);}
+			}
+
+			nn_it.sort();
+			nn_bt.sort();
+
+			ret &= (nn_it.size() == nn_bt.size());
+			for (size_t k = 0 ; k < nn_it.size() && k < nn_bt.size() ; k++)
+			{ret &= (nn_it.get(k) == nn_bt.get(k));}
+
+			tot += n;
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+	BOOST_REQUIRE(tot > pos.size());
+}
+
+BOOST_AUTO_TEST_CASE( CellNNBatch_full )
+{
+	test_cell_nn_batch<float>(CL_NON_SYMMETRIC);
+	test_cell_nn_batch<double>(CL_NON_SYMMETRIC);
+}
+
+BOOST_AUTO_TEST_CASE( CellNNBatch_full_small_grain )
+{
+	// the cell-list is filled by the parallel code path also with few particles
+
+	size_t grain = openfpm::cpu_parallel_grain();
+	openfpm::cpu_parallel_grain() = 64;
+
+	test_cell_nn_batch<float>(CL_NON_SYMMETRIC);
+	test_cell_nn_batch<double>(CL_NON_SYMMETRIC);
+
+	openfpm::cpu_parallel_grain() = grain;
+}
+
+// in SE_CLASS1 the cell list consider the symmetric iterator on a non symmetric
+// construction as an hack, disable the test
+
+#ifndef SE_CLASS1
+
+BOOST_AUTO_TEST_CASE( CellNNBatch_sym )
+{
+	test_cell_nn_batch<float>(CL_SYMMETRIC);
+	test_cell_nn_batch<double>(CL_SYMMETRIC);
+}
+
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
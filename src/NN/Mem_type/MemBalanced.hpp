@@ -15,6 +15,7 @@
 #include "util/mathutil.hpp"
 #include "NN/CellList/CellNNIterator.hpp"
 #include "Space/Shape/HyperCube.hpp"
+#include "util/cpu_parallel_util.hpp"
 
 /*! \brief Class for BALANCED cell list implementation
  *
@@ -71,6 +72,16 @@ public:
 		clear();
 	}
 
+	/*! \brief Return the number of cells
+	 *
+	 * \return the number of cells
+	 *
+	 */
+	inline size_t size() const
+	{
+		return cl_base.size();
+	}
+
 	/*! \brief Copy mem balanced
 	 *
 	 * \param cell memory to copy
@@ -109,6 +120,58 @@ public:
 		this->addCell(cell_id,ele);
 	}
 
+	/*! \brief Complete a batch of add(), nothing to do the elements are inserted directly
+	 *
+	 */
+	inline void finalize()
+	{}
+
+	/*! \brief Fill the structure in one shot
+	 *
+	 * It produce the same result of clear() followed by add(cells[i],i) for i = 0 ... n-1,
+	 * the elements are bucketed and copied in parallel
+	 *
+	 * \param cells cell of each element
+	 * \param n number of elements
+	 *
+	 */
+	inline void fill(const local_index * cells, size_t n)
+	{
+		size_t n_cell = cl_base.size();
+
+		std::vector<local_index> ele(n);
+		std::vector<local_index> start(n_cell+1);
+
+		openfpm::cpu_bucket_sort(cells,n,n_cell,ele.data(),start.data());
+
+		fill_csr(start.data(),ele.data(),n_cell);
+	}
+
+	/*! \brief Fill the structure in one shot from a CSR representation
+	 *
+	 * It produce the same result of clear() followed by add(c,ele[j]) for every cell c
+	 * and j = start[c] ... start[c+1]-1
+	 *
+	 * \param start start of each cell in ele (n_cell+1 elements)
+	 * \param ele elements cell by cell
+	 * \param n_cell number of cells (must match the number of cells of the structure)
+	 *
+	 */
+	inline void fill_csr(const local_index * start, const local_index * ele, size_t n_cell)
+	{
+		// allocation is serial, the copy is parallel
+
+		for (size_t c = 0 ; c < n_cell ; c++)
+		{cl_base.get(c).resize(start[c+1] - start[c]);}
+
+		#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(start[n_cell] + n_cell)) schedule(static)
+		for (size_t c = 0 ; c < n_cell ; c++)
+		{
+			for (local_index j = start[c] ; j < start[c+1] ; j++)
+			{cl_base.get(c).get(j - start[c]) = ele[j];}
+		}
+	}
+
 	/*! \brief Remove an element from the cell
 	 *
 	 * \param cell id of the cell
@@ -0,0 +1,509 @@
+/*
+ * MemCompact.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef MEMCOMPACT_HPP_
+#define MEMCOMPACT_HPP_
+
+#include "config.h"
+#include "Space/SpaceBox.hpp"
+#include "util/mathutil.hpp"
+#include "Space/Shape/HyperCube.hpp"
+#include "NN/CellList/CellListIterator.hpp"
+#include "util/common.hpp"
+#include "Vector/map_vector.hpp"
+#include "util/cpu_parallel_util.hpp"
+
+/*! \brief It is a class that work like a vector of vector stored in CSR format
+ *
+ * \tparam Memory memory used to allocate the internal buffers
+ * \tparam local_index type used for the local index
+ *
+ * The elements of all the vectors(2) are stored contiguously in one array (ids) of size N
+ * (N = total number of elements), the vector(2) i span the range [starts(i),starts(i+1)).
+ * The memory allocation is (M+1)*sizeof(local_index) + N*sizeof(local_index) where
+ * M is the number of vectors(2) (cells) independently from the distribution of the elements.
+ *
+ * Elements added with add() are buffered, the CSR structure is (re)constructed with a counting
+ * sort (count, prefix-sum, scatter) by finalize(). The order of the elements inside a cell is
+ * the order in which they has been added, as for Mem_fast. fill() and fill_csr() construct
+ * the CSR directly.
+ *
+ * The call order is add() ... add(), finalize(), then read. If a getter find elements added
+ * and not finalized it call finalize() itself, so a read never return stale data. The getters
+ * modify the structure only in this case: to read concurrently (for example from an OpenMP
+ * loop) finalize() must be called before. CellList::fill(), update() and finalize() already
+ * leave the structure finalized.
+ *
+ * \note remove() is O(N), this memory type is intended for structures constructed in bulk
+ *
+ */
+template <typename Memory = HeapMemory, typename local_index = size_t>
+class Mem_compact
+{
+	//! base that store the data
+	typedef typename openfpm::vector<aggregate<local_index>,Memory> base;
+
+	//! Start of each cell in ids (one element more than the number of cells)
+	base starts;
+
+	//! elements stored cell by cell (one element more than the number of elements
+	//! so that the stop of the last cell is addressable)
+	base ids;
+
+	//! cells of the elements added and not yet inserted in the CSR
+	base add_cell;
+
+	//! elements added and not yet inserted in the CSR
+	base add_ele;
+
+	//! temporal buffer used for the construction
+	base tmp;
+
+	/*! \brief Insert the elements added and not yet inserted before a read
+	 *
+	 * It is a single size check when the structure is finalized
+	 *
+	 */
+	inline void check_finalized() const
+	{
+		if (add_cell.size() != 0)
+		{const_cast<Mem_compact<Memory,local_index> *>(this)->finalize();}
+	}
+
+public:
+
+	typedef void toKernel_type;
+
+	//! expose the type of the local index
+	typedef local_index local_index_type;
+
+	/*! \brief return the number of cells
+	 *
+	 * \return the number of cells
+	 *
+	 */
+	inline size_t size() const
+	{
+		return starts.size() - 1;
+	}
+
+	/*! \brief Destroy the internal memory including the retained one
+	 *
+	 */
+	inline void destroy()
+	{
+		starts.swap(base());
+		ids.swap(base());
+		add_cell.swap(base());
+		add_ele.swap(base());
+		tmp.swap(base());
+
+		starts.resize(1);
+		starts.template get<0>(0) = 0;
+		ids.resize(1);
+	}
+
+	/*! \brief Initialize the data to zero
+	 *
+	 * \param slot unused
+	 * \param tot_n_cell total number of cells
+	 *
+	 */
+	inline void init_to_zero(local_index slot, local_index tot_n_cell)
+	{
+		starts.resize(tot_n_cell+1);
+		starts.template fill<0>(0);
+
+		ids.resize(1);
+
+		add_cell.clear();
+		add_ele.clear();
+	}
+
+	/*! \brief copy an object Mem_compact
+	 *
+	 * \param mem Mem_compact to copy
+	 *
+	 */
+	inline void operator=(const Mem_compact<Memory,local_index> & mem)
+	{
+		starts = mem.starts;
+		ids = mem.ids;
+		add_cell = mem.add_cell;
+		add_ele = mem.add_ele;
+	}
+
+	/*! \brief copy an object Mem_compact
+	 *
+	 * \param mem Mem_compact to copy
+	 *
+	 */
+	inline void operator=(Mem_compact<Memory,local_index> && mem)
+	{
+		this->swap(mem);
+	}
+
+	/*! \brief Add an element to the cell
+	 *
+	 * \param cell_id id of the cell
+	 * \param ele element to add
+	 *
+	 */
+	inline void addCell(local_index cell_id, local_index ele)
+	{
+		add_cell.add();
+		add_cell.template get<0>(add_cell.size()-1) = cell_id;
+		add_ele.add();
+		add_ele.template get<0>(add_ele.size()-1) = ele;
+	}
+
+	/*! \brief Add an element to the cell
+	 *
+	 * \param cell_id id of the cell
+	 * \param ele element to add
+	 *
+	 */
+	inline void add(local_index cell_id, local_index ele)
+	{
+		this->addCell(cell_id,ele);
+	}
+
+	/*! \brief Insert the buffered elements into the CSR structure
+	 *
+	 * Two pass counting sort, the first pass count the elements of each cell,
+	 * a prefix sum produce the new starts and a second pass scatter the elements.
+	 * It must be called after add() and before reading the structure concurrently,
+	 * a sequential read call it if needed
+	 *
+	 */
+	inline void finalize()
+	{
+		if (add_cell.size() == 0)	{return;}
+
+		size_t n_cell = starts.size() - 1;
+		size_t n_old = starts.template get<0>(n_cell);
+		size_t n_add = add_cell.size();
+
+		// count the elements in each cell
+
+		tmp.resize(n_cell+1);
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{tmp.template get<0>(i) = starts.template get<0>(i+1) - starts.template get<0>(i);}
+
+		for (size_t i = 0 ; i < n_add ; i++)
+		{tmp.template get<0>(add_cell.template get<0>(i))++;}
+
+		// exclusive prefix sum (tmp become the new starts)
+
+		local_index sum = 0;
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{
+			local_index cnt = tmp.template get<0>(i);
+			tmp.template get<0>(i) = sum;
+			sum += cnt;
+		}
+		tmp.template get<0>(n_cell) = sum;
+
+		// scatter, first the old elements then the new one. We use
+		// starts as cursor
+
+		base ids_new;
+		ids_new.resize(n_old + n_add + 1);
+
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{
+			local_index dst = tmp.template get<0>(i);
+			local_index stop = starts.template get<0>(i+1);
+
+			for (local_index j = starts.template get<0>(i) ; j < stop ; j++, dst++)
+			{ids_new.template get<0>(dst) = ids.template get<0>(j);}
+
+			starts.template get<0>(i) = dst;
+		}
+
+		for (size_t i = 0 ; i < n_add ; i++)
+		{
+			local_index c = add_cell.template get<0>(i);
+			ids_new.template get<0>(starts.template get<0>(c)) = add_ele.template get<0>(i);
+			starts.template get<0>(c)++;
+		}
+
+		starts.swap(tmp);
+		ids.swap(ids_new);
+
+		add_cell.clear();
+		add_ele.clear();
+	}
+
+	/*! \brief Fill the structure in one shot
+	 *
+	 * It produce the same result of clear() followed by add(cells[i],i) for i = 0 ... n-1,
+	 * the CSR is constructed directly with a parallel bucket sort
+	 *
+	 * \param cells cell of each element
+	 * \param n number of elements
+	 *
+	 */
+	inline void fill(const local_index * cells, size_t n)
+	{
+		size_t n_cell = starts.size() - 1;
+
+		add_cell.clear();
+		add_ele.clear();
+
+		ids.resize(n+1);
+
+		openfpm::cpu_bucket_sort(cells,n,n_cell,&ids.template get<0>(0),&starts.template get<0>(0));
+	}
+
+	/*! \brief Fill the structure in one shot from a CSR representation
+	 *
+	 * It produce the same result of clear() followed by add(c,ele[j]) for every cell c
+	 * and j = start[c] ... start[c+1]-1
+	 *
+	 * \param start start of each cell in ele (n_cell+1 elements)
+	 * \param ele elements cell by cell
+	 * \param n_cell number of cells (must match the number of cells of the structure)
+	 *
+	 */
+	inline void fill_csr(const local_index * start, const local_index * ele, size_t n_cell)
+	{
+		size_t n = start[n_cell];
+
+		add_cell.clear();
+		add_ele.clear();
+
+		ids.resize(n+1);
+
+		#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(n)) schedule(static)
+		for (size_t i = 0 ; i < n ; i++)
+		{ids.template get<0>(i) = ele[i];}
+
+		for (size_t c = 0 ; c <= n_cell ; c++)
+		{starts.template get<0>(c) = start[c];}
+	}
+
+	/*! \brief Get an element in the cell
+	 *
+	 * \param cell id of the cell
+	 * \param ele element id in the cell
+	 *
+	 * \return the reference to the selected element
+	 *
+	 */
+	inline auto get(local_index cell, local_index ele) -> decltype(ids.template get<0>(0)) &
+	{
+		check_finalized();
+		return ids.template get<0>(starts.template get<0>(cell) + ele);
+	}
+
+	/*! \brief Get an element in the cell
+	 *
+	 * \param cell id of the cell
+	 * \param ele element id in the cell
+	 *
+	 * \return the reference to the selected element
+	 *
+	 */
+	inline auto get(local_index cell, local_index ele) const -> decltype(ids.template get<0>(0)) &
+	{
+		check_finalized();
+		return ids.template get<0>(starts.template get<0>(cell) + ele);
+	}
+
+	/*! \brief Remove an element in the cell
+	 *
+	 * The order of the other elements is preserved
+	 *
+	 * \param cell id of the cell
+	 * \param ele element id to remove
+	 *
+	 */
+	inline void remove(local_index cell, local_index ele)
+	{
+		finalize();
+
+		size_t n_cell = starts.size() - 1;
+		size_t n_ele = starts.template get<0>(n_cell);
+
+		for (size_t i = starts.template get<0>(cell) + ele + 1 ; i < n_ele ; i++)
+		{ids.template get<0>(i-1) = ids.template get<0>(i);}
+
+		for (size_t i = cell + 1 ; i <= n_cell ; i++)
+		{starts.template get<0>(i)--;}
+
+		ids.resize(n_ele);
+	}
+
+	/*! \brief Get the number of elements in the cell
+	 *
+	 * \param cell_id id of the cell
+	 *
+	 * \return the number of elements in the cell
+	 *
+	 */
+	inline size_t getNelements(const local_index cell_id) const
+	{
+		check_finalized();
+		return starts.template get<0>(cell_id+1) - starts.template get<0>(cell_id);
+	}
+
+	/*! \brief swap to Mem_compact object
+	 *
+	 * \param mem object to swap the memory with
+	 *
+	 */
+	inline void swap(Mem_compact<Memory,local_index> & mem)
+	{
+		starts.swap(mem.starts);
+		ids.swap(mem.ids);
+		add_cell.swap(mem.add_cell);
+		add_ele.swap(mem.add_ele);
+	}
+
+	/*! \brief swap to Mem_compact object
+	 *
+	 * \param mem object to swap the memory with
+	 *
+	 */
+	inline void swap(Mem_compact<Memory,local_index> && mem)
+	{
+		starts.swap(mem.starts);
+		ids.swap(mem.ids);
+		add_cell.swap(mem.add_cell);
+		add_ele.swap(mem.add_ele);
+	}
+
+	/*! \brief Delete all the elements in the Cell-list
+	 *
+	 *
+	 *
+	 */
+	inline void clear()
+	{
+		starts.template fill<0>(0);
+		ids.resize(1);
+
+		add_cell.clear();
+		add_ele.clear();
+	}
+
+	/*! \brief Get the first element of a cell (as reference)
+	 *
+	 * \param cell_id cell-id
+	 *
+	 * \return a reference to the first element
+	 *
+	 */
+	inline const local_index & getStartId(local_index cell_id) const
+	{
+		check_finalized();
+		return ids.template get<0>(starts.template get<0>(cell_id));
+	}
+
+	/*! \brief Get the last element of a cell (as reference)
+	 *
+	 * \param cell_id cell-id
+	 *
+	 * \return a reference to the last element
+	 *
+	 */
+	inline const local_index & getStopId(local_index cell_id) const
+	{
+		check_finalized();
+		return ids.template get<0>(starts.template get<0>(cell_id+1));
+	}
+
+	/*! \brief Just return the value pointed by part_id
+	 *
+	 * \param part_id
+	 *
+	 * \return the value pointed by part_id
+	 *
+	 */
+	inline const local_index & get_lin(const local_index * part_id) const
+	{
+		return *part_id;
+	}
+
+public:
+
+	//! expose the type of the local index
+	typedef local_index loc_index;
+
+	/*! \brief Constructor
+	 *
+	 * \param slot unused
+	 *
+	 */
+	inline Mem_compact(local_index slot)
+	{
+		starts.resize(1);
+		starts.template get<0>(0) = 0;
+		ids.resize(1);
+	}
+
+	/*! \brief Set the number of slot for each cell
+	 *
+	 * \param slot unused
+	 *
+	 */
+	inline void set_slot(local_index slot)
+	{}
+
+	/*! \brief Return the private data-structure starts
+	 *
+	 * \return starts
+	 *
+	 */
+	const base & private_get_starts() const
+	{
+		check_finalized();
+		return starts;
+	}
+
+	/*! \brief Return the private data-structure ids
+	 *
+	 * \return ids
+	 *
+	 */
+	const base & private_get_ids() const
+	{
+		check_finalized();
+		return ids;
+	}
+};
+
+/*! \brief Check if a memory type is Mem_compact
+ *
+ * Mem_compact remove an element in O(N), structures that update the content
+ * incrementally use it to reconstruct in bulk instead
+ *
+ * \tparam Mem_type memory type
+ *
+ */
+template<typename Mem_type>
+struct is_mem_compact
+{
+	//! false in general
+	static const bool value = false;
+};
+
+/*! \brief Check if a memory type is Mem_compact
+ *
+ * Specialization for Mem_compact
+ *
+ */
+template<typename Memory, typename local_index>
+struct is_mem_compact<Mem_compact<Memory,local_index>>
+{
+	//! true for Mem_compact
+	static const bool value = true;
+};
+
+
+#endif /* MEMCOMPACT_HPP_ */
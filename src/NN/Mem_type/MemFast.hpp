@@ -16,6 +16,7 @@
 #include <unordered_map>
 #include "util/common.hpp"
 #include "Vector/map_vector.hpp"
+#include "util/cpu_parallel_util.hpp"
 
 template <typename Memory, template <typename> class layout_base,typename local_index>
 class Mem_fast_ker
@@ -243,6 +244,75 @@ public:
 		this->addCell(cell_id,ele);
 	}
 
+	/*! \brief Complete a batch of add(), nothing to do the elements are inserted directly
+	 *
+	 */
+	inline void finalize()
+	{}
+
+	/*! \brief Fill the structure in one shot
+	 *
+	 * It produce the same result of clear() followed by add(cells[i],i) for i = 0 ... n-1,
+	 * but the elements are bucketed in parallel (histogram, prefix sum and scatter)
+	 *
+	 * \param cells cell of each element
+	 * \param n number of elements
+	 *
+	 */
+	inline void fill(const local_index * cells, size_t n)
+	{
+		size_t n_cell = cl_n.size();
+
+		std::vector<local_index> ele(n);
+		std::vector<local_index> start(n_cell+1);
+
+		openfpm::cpu_bucket_sort(cells,n,n_cell,ele.data(),start.data());
+
+		fill_csr(start.data(),ele.data(),n_cell);
+	}
+
+	/*! \brief Fill the structure in one shot from a CSR representation
+	 *
+	 * It produce the same result of clear() followed by add(c,ele[j]) for every cell c
+	 * and j = start[c] ... start[c+1]-1. The copy is done in parallel
+	 *
+	 * \param start start of each cell in ele (n_cell+1 elements)
+	 * \param ele elements cell by cell
+	 * \param n_cell number of cells (must match the number of cells of the structure)
+	 *
+	 */
+	inline void fill_csr(const local_index * start, const local_index * ele, size_t n_cell)
+	{
+		// number of elements in each cell
+
+		local_index max_cnt = 0;
+
+		#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(n_cell)) schedule(static) reduction(max:max_cnt)
+		for (size_t c = 0 ; c < n_cell ; c++)
+		{
+			local_index cnt = start[c+1] - start[c];
+			cl_n.template get<0>(c) = cnt;
+
+			if (cnt > max_cnt)	{max_cnt = cnt;}
+		}
+
+		// same number of slots the add() would have reached
+
+		local_index slot_old = slot;
+		while (max_cnt >= slot)
+		{slot *= 2;}
+
+		if (slot != slot_old)
+		{cl_base.resize(slot * n_cell);}
+
+		#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(start[n_cell] + n_cell)) schedule(static)
+		for (size_t c = 0 ; c < n_cell ; c++)
+		{
+			for (local_index j = start[c] ; j < start[c+1] ; j++)
+			{cl_base.template get<0>(c * slot + j - start[c]) = ele[j];}
+		}
+	}
+
 	/*! \brief Get an element in the cell
 	 *
 	 * \param cell id of the cell
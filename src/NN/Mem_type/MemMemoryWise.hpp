@@ -10,6 +10,7 @@
 #define CELLISTMEM_HPP_
 
 #include "NN/CellList/CellList.hpp"
+#include "hash_map/hopscotch_map.h"
 
 /*! \brief Class for MEMORY-WISE cell list implementation
  *
@@ -37,12 +38,16 @@ class Mem_mw
 	typedef openfpm::vector<local_index> base;
 
 	//! each cell has a dynamic structure
-	//! that store the elements in the cell
-	std::unordered_map<local_index,base> cl_base;
+	//! that store the elements in the cell, only the non-empty cells are in the
+	//! table (open addressing, no allocation per cell beside the element storage)
+	tsl::hopscotch_map<local_index,base> cl_base;
 
 	//! In case of invalid element return this
 	typename std::remove_reference<decltype(std::declval<openfpm::vector<local_index>>().get(0))>::type invalid;
 
+	//! total number of cells
+	size_t tot_n_cell = 0;
+
 public:
 
 	typedef void toKernel_type;
@@ -61,6 +66,17 @@ public:
 	inline void init_to_zero(local_index slot, local_index tot_n_cell)
 	{
 		clear();
+		this->tot_n_cell = tot_n_cell;
+	}
+
+	/*! \brief Return the number of cells
+	 *
+	 * \return the number of cells
+	 *
+	 */
+	inline size_t size() const
+	{
+		return tot_n_cell;
 	}
 
 	/*! \brief Copy two data-structure
@@ -73,6 +89,7 @@ public:
 	inline Mem_mw & operator=(const Mem_mw & cell)
 	{
 		cl_base = cell.cl_base;
+		tot_n_cell = cell.tot_n_cell;
 		return *this;
 	}
 
@@ -100,6 +117,49 @@ public:
 		this->addCell(cell_id,ele);
 	}
 
+	/*! \brief Complete a batch of add(), nothing to do the elements are inserted directly
+	 *
+	 */
+	inline void finalize()
+	{}
+
+	/*! \brief Fill the structure in one shot
+	 *
+	 * It produce the same result of clear() followed by add(cells[i],i) for i = 0 ... n-1
+	 *
+	 * \param cells cell of each element
+	 * \param n number of elements
+	 *
+	 */
+	inline void fill(const local_index * cells, size_t n)
+	{
+		clear();
+
+		for (size_t i = 0 ; i < n ; i++)
+		{cl_base[cells[i]].add(i);}
+	}
+
+	/*! \brief Fill the structure in one shot from a CSR representation
+	 *
+	 * It produce the same result of clear() followed by add(c,ele[j]) for every cell c
+	 * and j = start[c] ... start[c+1]-1
+	 *
+	 * \param start start of each cell in ele (n_cell+1 elements)
+	 * \param ele elements cell by cell
+	 * \param n_cell number of cells
+	 *
+	 */
+	inline void fill_csr(const local_index * start, const local_index * ele, size_t n_cell)
+	{
+		clear();
+
+		for (size_t c = 0 ; c < n_cell ; c++)
+		{
+			for (local_index j = start[c] ; j < start[c+1] ; j++)
+			{cl_base[c].add(ele[j]);}
+		}
+	}
+
 	/*! \brief Remove an element from the cell
 	 *
 	 * \param cell cell-id
@@ -133,7 +193,7 @@ public:
 		if (it == cl_base.end())
 			return invalid;
 
-		return it->second.get(ele);
+		return it.value().get(ele);
 	}
 
 
@@ -149,11 +209,13 @@ public:
 	inline void swap(Mem_mw & cl)
 	{
 		cl_base.swap(cl.cl_base);
+		std::swap(tot_n_cell,cl.tot_n_cell);
 	}
 
 	inline void swap(Mem_mw && cell)
 	{
 		cl_base.swap(cell.cl_base);
+		std::swap(tot_n_cell,cell.tot_n_cell);
 	}
 
 	inline void clear()
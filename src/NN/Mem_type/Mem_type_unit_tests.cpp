@@ -10,6 +10,7 @@
 #include "NN/Mem_type/MemFast.hpp"
 #include "NN/Mem_type/MemBalanced.hpp"
 #include "NN/Mem_type/MemMemoryWise.hpp"
+#include "NN/Mem_type/MemCompact.hpp"
 
 BOOST_AUTO_TEST_SUITE( Mem_type_test )
 
@@ -23,6 +24,7 @@ void test_mem_type()
 	mem.init_to_zero(128,10);
 
 	mem.add(0,5);
+	mem.finalize();
 
 	BOOST_REQUIRE_EQUAL(mem.getNelements(0),1ul);
 
@@ -37,7 +39,34 @@ BOOST_AUTO_TEST_CASE ( Mem_type_check )
 {
 	test_mem_type<Mem_fast<>>();
 	test_mem_type<Mem_bal<>>();
+	test_mem_type<Mem_compact<>>();
 	test_mem_type<Mem_mw<>>();
 }
 
+BOOST_AUTO_TEST_CASE ( Mem_compact_read_before_finalize )
+{
+	Mem_compact<> mem(128);
+
+	mem.init_to_zero(128,10);
+
+	mem.add(3,7);
+	mem.add(1,4);
+	mem.add(3,2);
+
+	// a read insert the elements added
+
+	const Mem_compact<> & mem_c = mem;
+
+	BOOST_REQUIRE_EQUAL(mem_c.getNelements(3),2ul);
+	BOOST_REQUIRE_EQUAL(mem.getNelements(1),1ul);
+	BOOST_REQUIRE_EQUAL(mem.get(3,0),7ul);
+	BOOST_REQUIRE_EQUAL(mem.get(3,1),2ul);
+	BOOST_REQUIRE_EQUAL(mem.get(1,0),4ul);
+
+	mem.add(1,9);
+
+	BOOST_REQUIRE_EQUAL(mem.get(1,1),9ul);
+	BOOST_REQUIRE_EQUAL(mem.getNelements(3),2ul);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
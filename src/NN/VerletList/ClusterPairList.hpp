@@ -0,0 +1,712 @@
+/*
+ * ClusterPairList.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_VERLETLIST_CLUSTERPAIRLIST_HPP_
+#define OPENFPM_DATA_SRC_NN_VERLETLIST_CLUSTERPAIRLIST_HPP_
+
+#include "NN/CellList/CellList.hpp"
+#include "util/cpu_parallel_util.hpp"
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+//! Coordinate given to the empty slots of a cluster (far from any particle)
+#define CLUSTER_PAD_POS 1e10
+
+/*! \brief Iterator across the j-clusters interacting with one i-cluster
+ *
+ * \tparam ClusterPairList_type type of the cluster-pair list
+ *
+ */
+template<typename ClusterPairList_type>
+class ClusterPairIterator
+{
+	//! i-cluster
+	size_t ci;
+
+	//! actual pair
+	size_t k;
+
+	//! end of the pairs of ci
+	size_t stop;
+
+	//! cluster-pair list
+	const ClusterPairList_type & cpl;
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param ci i-cluster
+	 * \param cpl cluster-pair list
+	 *
+	 */
+	ClusterPairIterator(size_t ci, const ClusterPairList_type & cpl)
+	:ci(ci),k(cpl.getPairStart(ci)),stop(cpl.getPairStart(ci+1)),cpl(cpl)
+	{}
+
+	/*! \brief Check if there is a next j-cluster
+	 *
+	 * \return true if there is a next j-cluster
+	 *
+	 */
+	bool isNext() const
+	{
+		return k < stop;
+	}
+
+	/*! \brief Go to the next j-cluster
+	 *
+	 * \return itself
+	 *
+	 */
+	ClusterPairIterator & operator++()
+	{
+		k++;
+		return *this;
+	}
+
+	/*! \brief Return the actual j-cluster
+	 *
+	 * \return the j-cluster id
+	 *
+	 */
+	size_t getJ() const
+	{
+		return cpl.getPairCluster(k);
+	}
+
+	/*! \brief Return the interaction mask
+	 *
+	 * bit a*cl_size + b is set if the particle a of the i-cluster interact with the particle b
+	 * of the j-cluster (both exist and are not the same particle)
+	 *
+	 * \return the mask
+	 *
+	 */
+	typename ClusterPairList_type::mask_type getMask() const
+	{
+		return cpl.getPairMask(k);
+	}
+
+	/*! \brief Return the positions of the i-cluster as SoA block pos[d][a]
+	 *
+	 * \return the positions of the i-cluster
+	 *
+	 */
+	auto getIPos() const -> decltype(cpl.getClusterPos(0))
+	{
+		return cpl.getClusterPos(ci);
+	}
+
+	/*! \brief Return the positions of the j-cluster as SoA block pos[d][b]
+	 *
+	 * \return the positions of the j-cluster
+	 *
+	 */
+	auto getJPos() const -> decltype(cpl.getClusterPos(0))
+	{
+		return cpl.getClusterPos(getJ());
+	}
+};
+
+/*! \brief Cluster-pair neighbor list
+ *
+ * The particles are grouped in clusters of cl_size particles that are spatially compact
+ * (the particles of a cell are binned in columns along the first dim-1 coordinates and sorted
+ * along the last one, as in GROMACS, see order_columns). The list store, for every
+ * cluster with domain particles (i-cluster), the clusters (j-clusters) whose bounding box is
+ * closer than the cut-off radius together with an interaction mask. The positions of every
+ * cluster are stored as SoA blocks T[dim][cl_size], so that a kernel can compute the
+ * cl_size x cl_size interactions of a cluster pair with SIMD instructions. Distances must
+ * still be checked against the cut-off radius inside the kernel
+ *
+ * \tparam dim dimensionality
+ * \tparam T type of space
+ * \tparam cl_size number of particles in a cluster (4 or 8 for SSE/AVX2/AVX-512 width)
+ * \tparam CellListImpl cell-list used for the construction
+ * \tparam vector_pos_type type of the position vector
+ *
+ * ### Usage
+ *
+ * \code
+ * ClusterPairList<3,float,8> cpl;
+ * cpl.Initialize(box,r_cut,pos,g_m);
+ *
+ * for (size_t ci = 0 ; ci < cpl.getNClusters() ; ci++)
+ * {
+ *     auto it = cpl.getPairIterator(ci);
+ *     while (it.isNext())
+ *     {
+ *         auto & xi = it.getIPos();
+ *         auto & xj = it.getJPos();
+ *         auto mask = it.getMask();
+ *         // cl_size x cl_size interactions
+ *         ++it;
+ *     }
+ * }
+ * \endcode
+ *
+ */
+template<unsigned int dim,
+		 typename T,
+		 unsigned int cl_size = 4,
+		 typename CellListImpl = CellList<dim,T,Mem_fast<>>,
+		 typename vector_pos_type = openfpm::vector<Point<dim,T>>>
+class ClusterPairList
+{
+public:
+
+	//! type of the interaction mask
+	typedef unsigned long int mask_type;
+
+	//! Invalid particle (empty slot of a cluster)
+	static const size_t invalid = (size_t)-1;
+
+private:
+
+	static_assert(cl_size*cl_size <= sizeof(mask_type)*8,"the interaction mask of a cluster pair must fit a mask_type");
+
+	//! internal cell-list
+	CellListImpl cli;
+
+	//! particles of each cluster
+	openfpm::vector<aggregate<size_t[cl_size]>> cl_part;
+
+	//! positions of each cluster as SoA block
+	openfpm::vector<aggregate<T[dim][cl_size]>> cl_pos;
+
+	//! bounding box of each cluster
+	openfpm::vector<Box<dim,T>> cl_box;
+
+	//! 1 if the cluster contain domain particles
+	openfpm::vector<aggregate<unsigned char>> cl_dom;
+
+	//! cell of each cluster
+	openfpm::vector<aggregate<size_t>> cl_cell;
+
+	//! start of the clusters of each cell
+	openfpm::vector<aggregate<size_t>> cell_cl;
+
+	//! start of the pairs of each i-cluster
+	openfpm::vector<aggregate<size_t>> pair_start;
+
+	//! j-cluster and interaction mask of each pair
+	openfpm::vector<aggregate<size_t,mask_type>> pairs;
+
+	/*! \brief Create a cluster from a set of particles
+	 *
+	 * \param c cluster id
+	 * \param cell cell of the cluster
+	 * \param ids particles
+	 * \param n number of particles (<= cl_size)
+	 * \param pos particle positions
+	 * \param is_dom true if the particles are domain particles
+	 *
+	 */
+	void make_cluster(size_t c, size_t cell, const size_t * ids, size_t n, const vector_pos_type & pos, bool is_dom)
+	{
+		Box<dim,T> bx;
+		for (size_t d = 0 ; d < dim ; d++)
+		{
+			bx.setLow(d,std::numeric_limits<T>::max());
+			bx.setHigh(d,-std::numeric_limits<T>::max());
+		}
+
+		for (size_t a = 0 ; a < cl_size ; a++)
+		{
+			if (a < n)
+			{
+				cl_part.template get<0>(c)[a] = ids[a];
+
+				for (size_t d = 0 ; d < dim ; d++)
+				{
+					T x = pos.template get<0>(ids[a])[d];
+					cl_pos.template get<0>(c)[d][a] = x;
+
+					if (x < bx.getLow(d))	{bx.setLow(d,x);}
+					if (x > bx.getHigh(d))	{bx.setHigh(d,x);}
+				}
+			}
+			else
+			{
+				cl_part.template get<0>(c)[a] = invalid;
+
+				for (size_t d = 0 ; d < dim ; d++)
+				{cl_pos.template get<0>(c)[d][a] = CLUSTER_PAD_POS;}
+			}
+		}
+
+		cl_box.get(c) = bx;
+		cl_dom.template get<0>(c) = is_dom;
+		cl_cell.template get<0>(c) = cell;
+	}
+
+	/*! \brief Square distance between the bounding boxes of two clusters
+	 *
+	 * \param ci cluster i
+	 * \param cj cluster j
+	 *
+	 * \return the square of the distance
+	 *
+	 */
+	T box_distance2(size_t ci, size_t cj) const
+	{
+		const Box<dim,T> & bi = cl_box.get(ci);
+		const Box<dim,T> & bj = cl_box.get(cj);
+
+		T d2 = 0;
+		for (size_t d = 0 ; d < dim ; d++)
+		{
+			T dl = bj.getLow(d) - bi.getHigh(d);
+			T dh = bi.getLow(d) - bj.getHigh(d);
+			T dd = (dl > dh)?dl:dh;
+
+			if (dd > 0)	{d2 += dd*dd;}
+		}
+
+		return d2;
+	}
+
+	/*! \brief Calculate the interaction mask of a cluster pair
+	 *
+	 * \param ci cluster i
+	 * \param cj cluster j
+	 *
+	 * \return the mask
+	 *
+	 */
+	mask_type calc_mask(size_t ci, size_t cj) const
+	{
+		mask_type mask = 0;
+
+		for (size_t a = 0 ; a < cl_size ; a++)
+		{
+			if (cl_part.template get<0>(ci)[a] == invalid)	{continue;}
+
+			for (size_t b = 0 ; b < cl_size ; b++)
+			{
+				if (cl_part.template get<0>(cj)[b] == invalid)	{continue;}
+				if (ci == cj && a == b)	{continue;}
+
+				mask |= (mask_type)1 << (a*cl_size + b);
+			}
+		}
+
+		return mask;
+	}
+
+	/*! \brief Order a group of particles (domain or ghost particles of one cell) in columns
+	 *
+	 * The group is binned in columns along the first dim-1 coordinates, the section of a column
+	 * is chosen so that cl_size particles fill approximately a cube. The particles of every column
+	 * are sorted along the last coordinate and the clusters are cut column by column, so that
+	 * every cluster is compact in all the directions
+	 *
+	 * \param ids particles of the group, in output ordered column by column
+	 * \param brk in output 1 for the first particle of every column 0 otherwise
+	 * \param n number of particles in the group
+	 * \param pos particle positions
+	 * \param key temporal buffer (column, last coordinate, particle)
+	 *
+	 * \return the number of clusters of the group
+	 *
+	 */
+	size_t order_columns(size_t * ids, unsigned char * brk, size_t n, const vector_pos_type & pos, std::vector<std::tuple<size_t,T,size_t>> & key)
+	{
+		if (n == 0)	{return 0;}
+
+		T lo[dim];
+		T ext[dim];
+
+		for (size_t d = 0 ; d < dim ; d++)
+		{
+			lo[d] = std::numeric_limits<T>::max();
+			ext[d] = -std::numeric_limits<T>::max();
+		}
+
+		for (size_t j = 0 ; j < n ; j++)
+		{
+			for (size_t d = 0 ; d < dim ; d++)
+			{
+				T x = pos.template get<0>(ids[j])[d];
+				if (x < lo[d])	{lo[d] = x;}
+				if (x > ext[d])	{ext[d] = x;}
+			}
+		}
+
+		T vol = 1;
+		for (size_t d = 0 ; d < dim ; d++)
+		{
+			ext[d] -= lo[d];
+			vol *= ext[d];
+		}
+
+		// side of a cube that contain cl_size particles
+
+		T side = (vol > 0)?std::pow(cl_size * vol / n,(T)1.0/dim):0;
+
+		size_t n_col[dim];
+		for (size_t d = 0 ; d + 1 < dim ; d++)
+		{n_col[d] = (side > 0)?std::max((size_t)1,(size_t)(ext[d] / side + 0.5)):1;}
+
+		key.resize(n);
+
+		for (size_t j = 0 ; j < n ; j++)
+		{
+			size_t col = 0;
+			for (size_t d = 0 ; d + 1 < dim ; d++)
+			{
+				size_t k = 0;
+				if (n_col[d] > 1)
+				{k = std::min(n_col[d] - 1,(size_t)((pos.template get<0>(ids[j])[d] - lo[d]) / ext[d] * n_col[d]));}
+
+				col = col * n_col[d] + k;
+			}
+
+			key[j] = std::make_tuple(col,pos.template get<0>(ids[j])[dim-1],ids[j]);
+		}
+
+		std::sort(key.begin(),key.end());
+
+		size_t n_cl = 0;
+		size_t n_in_col = 0;
+
+		for (size_t j = 0 ; j < n ; j++)
+		{
+			ids[j] = std::get<2>(key[j]);
+			brk[j] = (j == 0 || std::get<0>(key[j]) != std::get<0>(key[j-1]));
+
+			if (brk[j] == 1)	{n_in_col = 0;}
+			if (n_in_col % cl_size == 0)	{n_cl++;}
+			n_in_col++;
+		}
+
+		return n_cl;
+	}
+
+	/*! \brief Create the clusters from the cell-list
+	 *
+	 * \param cl Cell-list filled with all the particles
+	 * \param pos particle positions
+	 * \param g_m ghost marker
+	 *
+	 */
+	void create_clusters(CellListImpl & cl, const vector_pos_type & pos, size_t g_m)
+	{
+		size_t n_cell = cl.getNCells();
+
+		cell_cl.resize(n_cell+1);
+
+		// particles of every cell ordered in columns, domain and ghost particles go in different clusters
+
+		std::vector<size_t> cell_start(n_cell+1);
+
+		#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(n_cell)) schedule(static)
+		for (size_t c = 0 ; c < n_cell ; c++)
+		{cell_start[c] = cl.getNelements(c);}
+		cell_start[n_cell] = 0;
+
+		openfpm::cpu_scan(cell_start.data(),n_cell+1,cell_start.data());
+
+		std::vector<size_t> ord(cell_start[n_cell]);
+		std::vector<unsigned char> brk(cell_start[n_cell]);
+
+		#pragma omp parallel num_threads(openfpm::cpu_num_threads_for(pos.size() + n_cell))
+		{
+			std::vector<std::tuple<size_t,T,size_t>> key;
+
+			#pragma omp for schedule(static)
+			for (size_t c = 0 ; c < n_cell ; c++)
+			{
+				size_t * ids = ord.data() + cell_start[c];
+				unsigned char * bk = brk.data() + cell_start[c];
+				size_t n_ele = cell_start[c+1] - cell_start[c];
+
+				size_t n_dom = 0;
+				for (size_t j = 0 ; j < n_ele ; j++)
+				{
+					size_t p = cl.get(c,j);
+					if (p < g_m)	{ids[n_dom] = p; n_dom++;}
+				}
+
+				size_t k = n_dom;
+				for (size_t j = 0 ; j < n_ele ; j++)
+				{
+					size_t p = cl.get(c,j);
+					if (p >= g_m)	{ids[k] = p; k++;}
+				}
+
+				cell_cl.template get<0>(c) = order_columns(ids,bk,n_dom,pos,key) +
+				                             order_columns(ids + n_dom,bk + n_dom,n_ele - n_dom,pos,key);
+			}
+		}
+		cell_cl.template get<0>(n_cell) = 0;
+
+		openfpm::cpu_scan(&cell_cl.template get<0>(0),n_cell+1,&cell_cl.template get<0>(0));
+
+		size_t n_cl = cell_cl.template get<0>(n_cell);
+
+		cl_part.resize(n_cl);
+		cl_pos.resize(n_cl);
+		cl_box.resize(n_cl);
+		cl_dom.resize(n_cl);
+		cl_cell.resize(n_cl);
+
+		// cut the clusters, a cluster never span two columns
+
+		#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(pos.size() + n_cell)) schedule(static)
+		for (size_t c = 0 ; c < n_cell ; c++)
+		{
+			size_t cid = cell_cl.template get<0>(c);
+
+			for (size_t j = cell_start[c] ; j < cell_start[c+1] ; cid++)
+			{
+				size_t m = 1;
+				while (m < cl_size && j + m < cell_start[c+1] && brk[j+m] == 0)	{m++;}
+
+				make_cluster(cid,c,&ord[j],m,pos,ord[j] < g_m);
+				j += m;
+			}
+		}
+	}
+
+	/*! \brief Create the cluster pairs
+	 *
+	 * \param cl Cell-list
+	 * \param r_cut cut-off radius
+	 *
+	 */
+	void create_pairs(CellListImpl & cl, T r_cut)
+	{
+		T r_cut2 = r_cut * r_cut;
+
+		size_t n_cl = cl_part.size();
+		long int n_cell = cl.getNCells();
+
+		const auto & NNc = cl.private_get_NNc_full();
+
+		pair_start.resize(n_cl+1);
+
+		// two passes, count and fill
+
+		for (size_t pass = 0 ; pass < 2 ; pass++)
+		{
+			#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(n_cl*64)) schedule(dynamic,64)
+			for (size_t ci = 0 ; ci < n_cl ; ci++)
+			{
+				if (cl_dom.template get<0>(ci) == 0)
+				{
+					if (pass == 0)	{pair_start.template get<0>(ci) = 0;}
+					continue;
+				}
+
+				size_t np = (pass == 0)?0:pair_start.template get<0>(ci);
+				long int c = cl_cell.template get<0>(ci);
+
+				for (size_t n = 0 ; n < openfpm::math::pow(3,dim) ; n++)
+				{
+					long int cn = c + NNc[n];
+
+					if (cn < 0 || cn >= n_cell)	{continue;}
+
+					for (size_t cj = cell_cl.template get<0>(cn) ; cj < cell_cl.template get<0>(cn+1) ; cj++)
+					{
+						if (box_distance2(ci,cj) >= r_cut2)	{continue;}
+
+						if (pass == 1)
+						{
+							pairs.template get<0>(np) = cj;
+							pairs.template get<1>(np) = calc_mask(ci,cj);
+						}
+
+						np++;
+					}
+				}
+
+				if (pass == 0)	{pair_start.template get<0>(ci) = np;}
+			}
+
+			if (pass == 0)
+			{
+				pair_start.template get<0>(n_cl) = 0;
+				openfpm::cpu_scan(&pair_start.template get<0>(0),n_cl+1,&pair_start.template get<0>(0));
+				pairs.resize(pair_start.template get<0>(n_cl));
+			}
+		}
+	}
+
+public:
+
+	/*! \brief Initialize the cluster-pair list creating an internal cell-list
+	 *
+	 * \param box Domain where the particles live
+	 * \param r_cut cut-off radius
+	 * \param pos particle positions
+	 * \param g_m ghost marker (particles below g_m are domain particles)
+	 *
+	 */
+	void Initialize(const Box<dim,T> & box, T r_cut, const vector_pos_type & pos, size_t g_m)
+	{
+		size_t div[dim];
+		Box<dim,T> bt = box;
+
+		cl_param_calculate(bt,div,r_cut,Ghost<dim,T>(0.0));
+
+		cli.Initialize(bt,div);
+		cli.fill(pos,g_m);
+
+		create(cli,r_cut,pos,g_m);
+	}
+
+	/*! \brief Create the cluster-pair list from a filled cell-list
+	 *
+	 * The cell-list must contain all the particles and the cells must be bigger than r_cut
+	 *
+	 * \param cl Cell-list
+	 * \param r_cut cut-off radius
+	 * \param pos particle positions
+	 * \param g_m ghost marker (particles below g_m are domain particles)
+	 *
+	 */
+	void create(CellListImpl & cl, T r_cut, const vector_pos_type & pos, size_t g_m)
+	{
+		create_clusters(cl,pos,g_m);
+		create_pairs(cl,r_cut);
+	}
+
+	/*! \brief Return the number of clusters
+	 *
+	 * \return the number of clusters
+	 *
+	 */
+	size_t getNClusters() const
+	{
+		return cl_part.size();
+	}
+
+	/*! \brief Return true if the cluster contain domain particles
+	 *
+	 * \param c cluster
+	 *
+	 * \return true if it is a domain cluster
+	 *
+	 */
+	bool isDomainCluster(size_t c) const
+	{
+		return cl_dom.template get<0>(c) != 0;
+	}
+
+	/*! \brief Return the particle a of the cluster c
+	 *
+	 * \param c cluster
+	 * \param a slot in the cluster
+	 *
+	 * \return the particle id or invalid for an empty slot
+	 *
+	 */
+	size_t getClusterPart(size_t c, size_t a) const
+	{
+		return cl_part.template get<0>(c)[a];
+	}
+
+	/*! \brief Return the SoA block of positions of the cluster c
+	 *
+	 * \param c cluster
+	 *
+	 * \return the positions pos[d][a]
+	 *
+	 */
+	auto getClusterPos(size_t c) const -> decltype(cl_pos.template get<0>(c))
+	{
+		return cl_pos.template get<0>(c);
+	}
+
+	/*! \brief Return the bounding box of the cluster c
+	 *
+	 * \param c cluster
+	 *
+	 * \return the bounding box
+	 *
+	 */
+	Box<dim,T> getClusterBox(size_t c) const
+	{
+		return cl_box.get(c);
+	}
+
+	/*! \brief Return the first pair of the cluster ci
+	 *
+	 * \param ci cluster
+	 *
+	 * \return the first pair
+	 *
+	 */
+	size_t getPairStart(size_t ci) const
+	{
+		return pair_start.template get<0>(ci);
+	}
+
+	/*! \brief Return the j-cluster of the pair k
+	 *
+	 * \param k pair
+	 *
+	 * \return the j-cluster
+	 *
+	 */
+	size_t getPairCluster(size_t k) const
+	{
+		return pairs.template get<0>(k);
+	}
+
+	/*! \brief Return the interaction mask of the pair k
+	 *
+	 * \param k pair
+	 *
+	 * \return the mask
+	 *
+	 */
+	mask_type getPairMask(size_t k) const
+	{
+		return pairs.template get<1>(k);
+	}
+
+	/*! \brief Return the number of j-clusters of the cluster ci
+	 *
+	 * \param ci cluster
+	 *
+	 * \return the number of j-clusters
+	 *
+	 */
+	size_t getNPairs(size_t ci) const
+	{
+		return pair_start.template get<0>(ci+1) - pair_start.template get<0>(ci);
+	}
+
+	/*! \brief Get an iterator across the j-clusters of the cluster ci
+	 *
+	 * \param ci i-cluster
+	 *
+	 * \return the iterator
+	 *
+	 */
+	ClusterPairIterator<ClusterPairList<dim,T,cl_size,CellListImpl,vector_pos_type>> getPairIterator(size_t ci) const
+	{
+		return ClusterPairIterator<ClusterPairList<dim,T,cl_size,CellListImpl,vector_pos_type>>(ci,*this);
+	}
+
+	/*! \brief Get the internal cell-list
+	 *
+	 * \return the internal cell-list
+	 *
+	 */
+	CellListImpl & getInternalCellList()
+	{
+		return cli;
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_NN_VERLETLIST_CLUSTERPAIRLIST_HPP_ */
@@ -0,0 +1,169 @@
+/*
+ * ClusterPairList_unit_tests.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include "NN/VerletList/ClusterPairList.hpp"
+
+BOOST_AUTO_TEST_SUITE( ClusterPairList_test )
+
+/*! \brief Check the cluster-pair list against a brute force search
+ *
+ * \tparam cl_size number of particles in a cluster
+ *
+ * \param g_m number of domain particles
+ *
+ * \return the average extent (maximum side of the bounding box) of the full domain clusters
+ *
+ */
+template<unsigned int cl_size>
+double test_cluster_pair_list(size_t g_m)
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	double r_cut = 0.1;
+
+	std::default_random_engine eg(cl_size);
+	std::uniform_real_distribution<double> ud(0.0,1.0);
+	std::uniform_real_distribution<double> ug(-0.05,0.0);
+
+	openfpm::vector<Point<3,double>> pos;
+
+	// domain particles
+	for (size_t i = 0 ; i < g_m ; i++)
+	{pos.add(Point<3,double>({ud(eg),ud(eg),ud(eg)}));}
+
+	// ghost particles on the low side
+	for (size_t i = 0 ; i < 500 ; i++)
+	{pos.add(Point<3,double>({ug(eg),ud(eg),ud(eg)}));}
+
+	ClusterPairList<3,double,cl_size> cpl;
+	cpl.Initialize(box,r_cut,pos,g_m);
+
+	// every particle is in exactly one cluster, domain and ghost are not mixed
+
+	openfpm::vector<size_t> seen(pos.size());
+	seen.fill(0);
+
+	for (size_t c = 0 ; c < cpl.getNClusters() ; c++)
+	{
+		for (size_t a = 0 ; a < cl_size ; a++)
+		{
+			size_t p = cpl.getClusterPart(c,a);
+			if (p == cpl.invalid)	{continue;}
+
+			seen.get(p)++;
+			BOOST_REQUIRE_EQUAL(cpl.isDomainCluster(c),p < g_m);
+
+			for (size_t d = 0 ; d < 3 ; d++)
+			{BOOST_REQUIRE_EQUAL(cpl.getClusterPos(c)[d][a],pos.template get<0>(p)[d]);}
+		}
+	}
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{BOOST_REQUIRE_EQUAL(seen.get(i),1ul);}
+
+	// count the interactions covered by the masks within r_cut
+
+	openfpm::vector<size_t> n_cpl(g_m);
+	n_cpl.fill(0);
+
+	for (size_t ci = 0 ; ci < cpl.getNClusters() ; ci++)
+	{
+		if (cpl.isDomainCluster(ci) == false)
+		{
+			BOOST_REQUIRE_EQUAL(cpl.getNPairs(ci),0ul);
+			continue;
+		}
+
+		auto it = cpl.getPairIterator(ci);
+
+		while (it.isNext())
+		{
+			auto mask = it.getMask();
+
+			for (size_t a = 0 ; a < cl_size ; a++)
+			{
+				for (size_t b = 0 ; b < cl_size ; b++)
+				{
+					if ((mask & ((decltype(mask))1 << (a*cl_size + b))) == 0)	{continue;}
+
+					double r2 = 0.0;
+					for (size_t d = 0 ; d < 3 ; d++)
+					{
+						double dx = it.getIPos()[d][a] - it.getJPos()[d][b];
+						r2 += dx*dx;
+					}
+
+					if (r2 < r_cut*r_cut)
+					{n_cpl.get(cpl.getClusterPart(ci,a))++;}
+				}
+			}
+
+			++it;
+		}
+	}
+
+	// brute force
+
+	bool ret = true;
+	for (size_t i = 0 ; i < g_m ; i++)
+	{
+		size_t n = 0;
+		for (size_t j = 0 ; j < pos.size() ; j++)
+		{
+			if (i == j)	{continue;}
+			if (Point<3,double>(pos.get(i)).distance2(pos.get(j)) < r_cut*r_cut)	{n++;}
+		}
+
+		ret &= (n == n_cpl.get(i));
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+
+	// average extent of the full domain clusters
+
+	double ext = 0.0;
+	size_t n_full = 0;
+
+	for (size_t c = 0 ; c < cpl.getNClusters() ; c++)
+	{
+		if (cpl.isDomainCluster(c) == false || cpl.getClusterPart(c,cl_size-1) == cpl.invalid)	{continue;}
+
+		Box<3,double> bx = cpl.getClusterBox(c);
+
+		double e = 0.0;
+		for (size_t d = 0 ; d < 3 ; d++)
+		{e = std::max(e,bx.getHigh(d) - bx.getLow(d));}
+
+		ext += e;
+		n_full++;
+	}
+
+	return (n_full == 0)?0.0:ext / n_full;
+}
+
+BOOST_AUTO_TEST_CASE( ClusterPairList_4 )
+{
+	test_cluster_pair_list<4>(3000);
+}
+
+BOOST_AUTO_TEST_CASE( ClusterPairList_8 )
+{
+	test_cluster_pair_list<8>(3000);
+}
+
+BOOST_AUTO_TEST_CASE( ClusterPairList_compact )
+{
+	// 20 particles per cell of side 0.1, a cube that contain 4 particles has a side of 0.06.
+	// Clusters cut only along the last coordinate span the full cell in x and y (extent ~0.07)
+
+	double ext = test_cluster_pair_list<4>(20000);
+	BOOST_REQUIRE(ext < 0.06);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -13,9 +13,13 @@
 #include "NN/Mem_type/MemFast.hpp"
 #include "NN/Mem_type/MemBalanced.hpp"
 #include "NN/Mem_type/MemMemoryWise.hpp"
+#include "NN/Mem_type/MemCompact.hpp"
 
 #define VERLET_STARTING_NSLOT 128
 
+//! Number of consecutive particles processed by a thread as one unit in the Verlet-list construction
+#define VERLET_PARALLEL_CHUNK 512
+
 
 #define WITH_RADIUS 3
 
@@ -53,6 +57,19 @@ struct NNType
 		return cl.template getNNIterator<NO_CHECK>(cl.getCell(xp));
 	}
 
+	/*! \brief Prepare the neighborhood before the parallel construction (nothing to do)
+	 *
+	 * \param cl Cell-list type implementation
+	 * \param r_cut Cutoff radius
+	 *
+	 * \return the cutoff radius passed to get
+	 *
+	 */
+	static inline T prepare(CellListImpl & cl, T r_cut)
+	{
+		return r_cut;
+	}
+
 	/*! \brief Add particle in the list of the domain particles
 	 *
 	 * \param p particle id
@@ -84,7 +101,7 @@ struct NNType<dim,T,CellListImpl,PartIt,WITH_RADIUS,local_index>
 	 * \param xp Position of the particle p
 	 * \param p id of the particle p
 	 * \param cl Cell-list type implementation
-	 * \param r_cut Cutoff radius
+	 * \param NNc neighborhood cells returned by prepare
 	 *
 	 * \return the NN iterator
 	 *
@@ -95,9 +112,22 @@ struct NNType<dim,T,CellListImpl,PartIt,WITH_RADIUS,local_index>
 						   Point<dim,T> & xp,
 						   size_t p,
 						   CellListImpl & cl,
-						   T r_cut) -> decltype(cl.template getNNIteratorRadius<NO_CHECK>(0,0.0))
+						   const openfpm::vector<long int> & NNc) -> decltype(cl.template getNNIteratorRadius<NO_CHECK>(0,NNc))
+	{
+		return cl.template getNNIteratorRadius<NO_CHECK>(cl.getCell(xp),NNc);
+	}
+
+	/*! \brief Calculate the neighborhood cells within the radius (serially, the Cell-list cache it)
+	 *
+	 * \param cl Cell-list type implementation
+	 * \param r_cut Cutoff radius
+	 *
+	 * \return the neighborhood cells passed to get
+	 *
+	 */
+	static inline const openfpm::vector<long int> & prepare(CellListImpl & cl, T r_cut)
 	{
-		return cl.template getNNIteratorRadius<NO_CHECK>(cl.getCell(xp),r_cut);
+		return cl.getNNcRadius(r_cut);
 	}
 
 	/*! \brief Add particle in the list of the domain particles
@@ -147,6 +177,19 @@ struct NNType<dim,T,CellListImpl,PartIt,VL_SYMMETRIC,local_index>
 		return cl.template getNNIteratorSym<NO_CHECK>(cl.getCell(xp),p,v);
 	}
 
+	/*! \brief Prepare the neighborhood before the parallel construction (nothing to do)
+	 *
+	 * \param cl Cell-list type implementation
+	 * \param r_cut Cutoff radius
+	 *
+	 * \return the cutoff radius passed to get
+	 *
+	 */
+	static inline T prepare(CellListImpl & cl, T r_cut)
+	{
+		return r_cut;
+	}
+
 	/*! \brief Add particle in the list of the domain particles
 	 *
 	 * \param p particle id
@@ -196,6 +239,19 @@ struct NNType<dim,T,CellListImpl,PartIt,VL_CRS_SYMMETRIC,local_index>
 	}
 
 
+	/*! \brief Prepare the neighborhood before the parallel construction (nothing to do)
+	 *
+	 * \param cl Cell-list type implementation
+	 * \param r_cut Cutoff radius
+	 *
+	 * \return the cutoff radius passed to get
+	 *
+	 */
+	static inline T prepare(CellListImpl & cl, T r_cut)
+	{
+		return r_cut;
+	}
+
 	/*! \brief Add particle in the list of the domain particles
 	 *
 	 * \param p particle id
@@ -311,6 +367,18 @@ private:
 	//! Interlal cell-list
 	CellListImpl cli;
 
+	//! skin added to the cut-off radius (0 if the skin mode is not used)
+	T skin = 0;
+
+	//! cut-off radius (without skin) used in the skin mode
+	T r_cut_skin = 0;
+
+	//! option used to construct the Verlet-list in the skin mode
+	size_t opt_skin = VL_NON_SYMMETRIC;
+
+	//! positions of the particles at the last construction (skin mode)
+	vector_pos_type pos_last;
+
 
 	/*! \brief Fill the cell-list with data
 	 *
@@ -373,10 +441,14 @@ private:
 	 */
 	template<typename NN_type, int type> inline void create_(const vector_pos_type & pos, const vector_pos_type & pos2 , const openfpm::vector<size_t> & dom, const openfpm::vector<subsub_lin<dim>> & anom, T r_cut, size_t g_m, CellListImpl & cli, size_t opt)
 	{
+		typedef typename Mem_type::local_index_type local_index;
+
 		size_t end;
 
 		auto it = PartItNN<type,dim,vector_pos_type,CellListImpl>::get(pos,dom,anom,cli,g_m,end);
 
+		typedef NNType<dim,T,CellListImpl,decltype(it),type,local_index> NNT;
+
 		Mem_type::init_to_zero(slot,end);
 
 		dp.clear();
@@ -384,31 +456,97 @@ private:
 		// square of the cutting radius
 		T r_cut2 = r_cut * r_cut;
 
-		// iterate the particles
-		while (it.isNext())
+		// what the threads need to get the neighborhood, calculated serially
+		const auto & nn_par = NNT::prepare(cli,r_cut);
+
+		// Walk the particles serially and save the iterator every VERLET_PARALLEL_CHUNK
+		// particles, every saved iterator is the start of an independent chunk of work
+
+		std::vector<decltype(it)> chunks;
+
+		for (size_t n_it = 0 ; it.isNext() ; n_it++)
 		{
-			typename Mem_type::local_index_type i = it.get();
-			Point<dim,T> xp = pos.template get<0>(i);
+			if (n_it % VERLET_PARALLEL_CHUNK == 0)
+			{chunks.push_back(it);}
 
-			// Get the neighborhood of the particle
-			auto NN = NNType<dim,T,CellListImpl,decltype(it),type,typename Mem_type::local_index_type>::get(it,pos,xp,i,cli,r_cut);
-			NNType<dim,T,CellListImpl,decltype(it),type,typename Mem_type::local_index_type>::add(i,dp);
+			NNT::add(it.get(),dp);
 
-			while (NN.isNext())
+			++it;
+		}
+
+		// every thread process a contiguous range of chunks and store the neighborhood
+		// in a private buffer
+
+		int nt = (chunks.size() < (size_t)openfpm::cpu_num_threads())?chunks.size():openfpm::cpu_num_threads();
+		if (nt == 0)	{nt = 1;}
+
+		std::vector<local_index> cnt(end+1);
+		std::vector<std::vector<local_index>> nn_buf(nt);
+		std::vector<std::vector<local_index>> part_buf(nt);
+
+		#pragma omp parallel num_threads(nt)
+		{
+			int t = openfpm::cpu_thread_id();
+
+			size_t c_start;
+			size_t c_stop;
+			openfpm::cpu_chunk(chunks.size(),openfpm::cpu_team_size(),t,c_start,c_stop);
+
+			for (size_t c = c_start ; c < c_stop ; c++)
 			{
-				auto nnp = NN.get();
+				auto it_c = chunks[c];
 
-				Point<dim,T> xq = pos2.template get<0>(nnp);
+				for (size_t k = 0 ; k < VERLET_PARALLEL_CHUNK && it_c.isNext() ; k++)
+				{
+					local_index i = it_c.get();
+					Point<dim,T> xp = pos.template get<0>(i);
 
-				if (xp.distance2(xq) < r_cut2)
-					addPart(i,nnp);
+					size_t n_start = nn_buf[t].size();
 
-				// Next particle
-				++NN;
+					// Get the neighborhood of the particle
+					auto NN = NNT::get(it_c,pos,xp,i,cli,nn_par);
+
+					while (NN.isNext())
+					{
+						auto nnp = NN.get();
+
+						Point<dim,T> xq = pos2.template get<0>(nnp);
+
+						if (xp.distance2(xq) < r_cut2)
+						{nn_buf[t].push_back(nnp);}
+
+						// Next particle
+						++NN;
+					}
+
+					cnt[i] = nn_buf[t].size() - n_start;
+					part_buf[t].push_back(i);
+
+					++it_c;
+				}
 			}
+		}
 
-			++it;
+		// join the private buffers into one CSR
+
+		openfpm::cpu_scan(cnt.data(),end+1,cnt.data());
+
+		std::vector<local_index> ele(cnt[end]);
+
+		#pragma omp parallel for num_threads(nt) schedule(static)
+		for (int t = 0 ; t < nt ; t++)
+		{
+			size_t b = 0;
+			for (size_t k = 0 ; k < part_buf[t].size() ; k++)
+			{
+				local_index i = part_buf[t][k];
+
+				for (local_index j = cnt[i] ; j < cnt[i+1] ; j++, b++)
+				{ele[j] = nn_buf[t][b];}
+			}
 		}
+
+		Mem_type::fill_csr(cnt.data(),ele.data(),end);
 	}
 
 	/*! \brief Create the Verlet list from a given cell-list with a particular cut-off radius
@@ -449,6 +587,8 @@ private:
 				++NN;
 			}
 		}
+
+		Mem_type::finalize();
 	}
 
 public:
@@ -483,6 +623,25 @@ public:
 		Mem_type::addCell(part_id,ele);
 	}
 
+	/*! \brief Set the neighborhood of all the particles from a CSR representation
+	 *
+	 * The neighborhood of the particle i is ele[start[i]] ... ele[start[i+1]-1]
+	 *
+	 * \param start start of the neighborhood of each particle in ele (n_part+1 elements)
+	 * \param ele neighborhood particles
+	 * \param n_part number of particles
+	 *
+	 */
+	inline void setFromCSR(const typename Mem_type::local_index_type * start,
+			               const typename Mem_type::local_index_type * ele,
+			               size_t n_part)
+	{
+		Mem_type::init_to_zero(slot,n_part);
+		dp.clear();
+
+		Mem_type::fill_csr(start,ele,n_part);
+	}
+
 	/*! Initialize the verlet list
 	 *
 	 * \param box Domain where this cell list is living
@@ -618,6 +777,112 @@ public:
 		create(pos, pos,dom_c,anom_c,r_cut,g_m,cli,opt);
 	}
 
+	/*! \brief Initialize the Verlet-list with a skin
+	 *
+	 * The Verlet-list is constructed with a cut-off radius r_cut + skin, and the positions of
+	 * the particles are saved. updateSkin() reconstruct the list only when at least one particle
+	 * has moved more than skin/2 from the last construction. Because the list contain the
+	 * particles up to r_cut + skin, the interaction loops must check the distance against r_cut
+	 *
+	 * \param box Domain where this cell list is living
+	 * \param dom Processor domain
+	 * \param r_cut cut-off radius
+	 * \param skin skin
+	 * \param pos vector of particle positions
+	 * \param g_m Indicate form which particles to construct the verlet list
+	 * \param opt VL_NON_SYMMETRIC or VL_SYMMETRIC
+	 *
+	 */
+	void InitializeSkin(const Box<dim,T> & box, const Box<dim,T> & dom, T r_cut, T skin, vector_pos_type & pos, size_t g_m, size_t opt = VL_NON_SYMMETRIC)
+	{
+		this->skin = skin;
+		r_cut_skin = r_cut;
+		opt_skin = opt;
+
+		Initialize(box,dom,r_cut + skin,pos,g_m,opt);
+
+		pos_last = pos;
+	}
+
+	/*! \brief Return the square of the maximum displacement of the particles from the last construction
+	 *
+	 * \param pos vector of particle positions
+	 *
+	 * \return the square of the maximum displacement
+	 *
+	 */
+	T maxDisplacement2(const vector_pos_type & pos) const
+	{
+		size_t n = pos.size();
+		T max_d2 = 0;
+
+		#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(n)) schedule(static) reduction(max:max_d2)
+		for (size_t i = 0 ; i < n ; i++)
+		{
+			T d2 = 0;
+
+			for (size_t j = 0 ; j < dim ; j++)
+			{
+				T dx = pos.template get<0>(i)[j] - pos_last.template get<0>(i)[j];
+				d2 += dx*dx;
+			}
+
+			max_d2 = (d2 > max_d2)?d2:max_d2;
+		}
+
+		return max_d2;
+	}
+
+	/*! \brief Check if the Verlet-list constructed with the skin is still valid
+	 *
+	 * \param pos vector of particle positions
+	 *
+	 * \return true if the Verlet-list must be reconstructed
+	 *
+	 */
+	bool needRebuild(const vector_pos_type & pos) const
+	{
+		if (pos.size() != pos_last.size())
+		{return true;}
+
+		return maxDisplacement2(pos) > skin*skin / 4;
+	}
+
+	/*! \brief update the Verlet-list initialized with InitializeSkin, only if needed
+	 *
+	 * \param pos vector of particle positions
+	 * \param g_m ghost marker
+	 *
+	 * \return true if the Verlet-list has been reconstructed
+	 *
+	 */
+	bool updateSkin(vector_pos_type & pos, size_t g_m)
+	{
+		if (needRebuild(pos) == false)
+		{return false;}
+
+		initCl(cli,pos,g_m,opt_skin);
+
+		openfpm::vector<subsub_lin<dim>> anom_c;
+		openfpm::vector<size_t> dom_c;
+
+		create(pos,pos,dom_c,anom_c,r_cut_skin + skin,g_m,cli,opt_skin);
+
+		pos_last = pos;
+
+		return true;
+	}
+
+	/*! \brief Return the skin
+	 *
+	 * \return the skin
+	 *
+	 */
+	T getSkin() const
+	{
+		return skin;
+	}
+
 	/*! \brief update the Verlet list
 	 *
 	 * \param r_cut cutoff radius
@@ -777,6 +1042,11 @@ public:
 
 		n_dec = vl.n_dec;
 
+		skin = vl.skin;
+		r_cut_skin = vl.r_cut_skin;
+		opt_skin = vl.opt_skin;
+		pos_last.swap(vl.pos_last);
+
 		return *this;
 	}
 
@@ -799,6 +1069,11 @@ public:
 		dp = vl.dp;
 		n_dec = vl.n_dec;
 
+		skin = vl.skin;
+		r_cut_skin = vl.r_cut_skin;
+		opt_skin = vl.opt_skin;
+		pos_last = vl.pos_last;
+
 		return *this;
 	}
 
@@ -846,6 +1121,11 @@ public:
 		size_t n_dec_tmp = vl.n_dec;
 		vl.n_dec = n_dec;
 		n_dec = n_dec_tmp;
+
+		std::swap(skin,vl.skin);
+		std::swap(r_cut_skin,vl.r_cut_skin);
+		std::swap(opt_skin,vl.opt_skin);
+		pos_last.swap(vl.pos_last);
 	}
 
 	/*! \brief Get the Neighborhood iterator
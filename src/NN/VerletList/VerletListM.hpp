@@ -8,6 +8,7 @@
 #ifndef OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETLISTM_HPP_
 #define OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETLISTM_HPP_
 
+#include "NN/CellList/CellListM.hpp"
 #include "NN/VerletList/VerletNNIteratorM.hpp"
 #include "VerletList.hpp"
 
@@ -247,6 +248,8 @@ class VerletListM : public VerletBase
 
 			++it;
 		}
+
+		this->finalize();
 	}
 
 public:
@@ -0,0 +1,376 @@
+/*
+ * VerletListMulti.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETLISTMULTI_HPP_
+#define OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETLISTMULTI_HPP_
+
+#include "NN/VerletList/VerletList.hpp"
+#include "NN/VerletList/VerletListM.hpp"
+#include "util/cpu_parallel_util.hpp"
+#include <vector>
+
+/*! \brief Selector that accept every pair in every list
+ *
+ */
+struct vl_multi_all
+{
+	/*! \brief Accept the pair
+	 *
+	 * \param k list
+	 * \param p particle
+	 * \param q neighborhood particle
+	 *
+	 * \return true
+	 *
+	 */
+	inline bool operator()(size_t k, size_t p, size_t q) const
+	{
+		return true;
+	}
+};
+
+/*! \brief Set of Verlet-lists with different cut-off radius constructed with one Cell-list traversal
+ *
+ * Constructing several Verlet-lists with different cut-off radius on the same Cell-list
+ * repeats the traversal of the neighborhood cells and the distance computation for every
+ * list. Here the neighborhood of every particle is traversed once with the biggest cut-off
+ * radius, the distance of every pair is computed once and the pair is written into every
+ * list k with d(p,q) < r_cut[k] accepted by a selector sel(k,p,q) (for example to
+ * construct species-pair dependent lists).
+ *
+ * With a Multi-Phase Cell-list (CellListM) InitializeM construct the lists of the phase
+ * pairs (pp,v), one for every phase v of the neighborhood, each one with its cut-off radius.
+ * The neighborhood particles are stored without the phase encoding
+ *
+ * Every list is a normal Verlet-list of type VerletBase
+ *
+ * \tparam dim Dimensionality of the space
+ * \tparam T type of the space float, double ...
+ * \tparam VerletBase type of the Verlet-lists
+ *
+ * ### Example
+ *
+ * \code
+ * openfpm::vector<T> r_cut;
+ * r_cut.add(0.05);
+ * r_cut.add(0.1);
+ *
+ * VerletListMulti<3,double> vlm;
+ * vlm.Initialize(cl,r_cut,pos,pos,g_m);
+ *
+ * auto NN = vlm.getList(1).getNNIterator(p);
+ * \endcode
+ *
+ */
+template<unsigned int dim,
+		 typename T,
+		 typename VerletBase = VerletList<dim,T,Mem_fast<>,shift<dim,T>> >
+class VerletListMulti
+{
+	//! type of the local index
+	typedef typename VerletBase::Mem_type_type::local_index_type local_index;
+
+	//! Verlet-lists
+	std::vector<VerletBase> vl;
+
+	/*! \brief Return true if the cut-off radius is not bigger than the cell spacing
+	 *
+	 * \param cli Cell-list
+	 * \param r_cut cut-off radius
+	 *
+	 * \return true if the neighborhood cells cover the cut-off radius
+	 *
+	 */
+	template<typename CellListImpl> static bool in_cell(CellListImpl & cli, T r_cut)
+	{
+		Point<dim,T> spacing = cli.getCellBox().getP2();
+
+		bool wr = true;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{wr &= r_cut <= spacing.get(i);}
+
+		return wr;
+	}
+
+	/*! \brief Square the cut-off radius and return the biggest one
+	 *
+	 * \param r_cut cut-off radius
+	 * \param r_cut2 square of the cut-off radius (output)
+	 *
+	 * \return the biggest cut-off radius
+	 *
+	 */
+	static T max_r_cut(const openfpm::vector<T> & r_cut, std::vector<T> & r_cut2)
+	{
+		T r_max = 0;
+
+		r_cut2.resize(r_cut.size());
+		for (size_t k = 0 ; k < r_cut.size() ; k++)
+		{
+			r_cut2[k] = r_cut.get(k)*r_cut.get(k);
+			r_max = (r_cut.get(k) > r_max)?r_cut.get(k):r_max;
+		}
+
+		return r_max;
+	}
+
+	/*! \brief Construct the lists
+	 *
+	 * The particles [0,g_m) are split into contiguous ranges, one for every thread. Every thread
+	 * store the neighborhood of its particles in a private buffer for every list, the buffers
+	 * are joined in a CSR for every list
+	 *
+	 * \param n_lists number of lists
+	 * \param g_m number of particles for which the lists are constructed
+	 * \param nn function nn(i,add) that traverse the neighborhood of the particle i and call
+	 *        add(k,q) for every particle q of the list k
+	 *
+	 */
+	template<typename nn_type> void create(size_t n_lists, size_t g_m, nn_type nn)
+	{
+		vl.resize(n_lists);
+
+		int nt = openfpm::cpu_num_threads_for(g_m);
+
+		std::vector<std::vector<local_index>> cnt(n_lists,std::vector<local_index>(g_m+1));
+		std::vector<std::vector<std::vector<local_index>>> nn_buf(nt,std::vector<std::vector<local_index>>(n_lists));
+		std::vector<size_t> start(nt+1);
+
+		#pragma omp parallel num_threads(nt)
+		{
+			int t = openfpm::cpu_thread_id();
+
+			size_t p_start;
+			size_t p_stop;
+			openfpm::cpu_chunk(g_m,openfpm::cpu_team_size(),t,p_start,p_stop);
+
+			start[t] = p_start;
+
+			std::vector<std::vector<local_index>> & buf = nn_buf[t];
+
+			for (size_t i = p_start ; i < p_stop ; i++)
+			{
+				for (size_t k = 0 ; k < n_lists ; k++)
+				{cnt[k][i] = buf[k].size();}
+
+				nn(i,[&](size_t k, size_t q){buf[k].push_back(q);});
+
+				for (size_t k = 0 ; k < n_lists ; k++)
+				{cnt[k][i] = buf[k].size() - cnt[k][i];}
+			}
+		}
+
+		// join the private buffers, the particles of a thread are contiguous
+
+		for (size_t k = 0 ; k < n_lists ; k++)
+		{
+			openfpm::cpu_scan(cnt[k].data(),g_m+1,cnt[k].data());
+
+			std::vector<local_index> ele(cnt[k][g_m]);
+
+			#pragma omp parallel for num_threads(nt) schedule(static)
+			for (int t = 0 ; t < nt ; t++)
+			{
+				const std::vector<local_index> & buf = nn_buf[t][k];
+				std::copy(buf.begin(),buf.end(),ele.begin() + cnt[k][start[t]]);
+			}
+
+			vl[k].setFromCSR(cnt[k].data(),ele.data(),g_m);
+		}
+	}
+
+public:
+
+	/*! \brief Initialize the lists from an already filled Cell-list
+	 *
+	 * \param cli external Cell-list
+	 * \param r_cut cut-off radius of every list
+	 * \param pos vector of particle positions
+	 * \param pos2 vector of particle position for the neighborhood
+	 * \param g_m Indicate form which particles to construct the verlet lists. For example
+	 * 			if we have 120 particles and g_m = 100, the Verlet lists will be constructed only for the first
+	 * 			100 particles
+	 * \param sel selector sel(k,p,q), the pair p,q is added to the list k only if it return true
+	 * \param opt options for the Verlet-list creation (VL_NON_SYMMETRIC or VL_SYMMETRIC)
+	 *
+	 */
+	template<typename CellListImpl, typename vector_pos_type, typename sel_type = vl_multi_all>
+	void Initialize(CellListImpl & cli,
+			        const openfpm::vector<T> & r_cut,
+			        const vector_pos_type & pos,
+			        const vector_pos_type & pos2,
+			        size_t g_m,
+			        sel_type sel = sel_type(),
+			        size_t opt = VL_NON_SYMMETRIC)
+	{
+		std::vector<T> r_cut2;
+		T r_max = max_r_cut(r_cut,r_cut2);
+		size_t n_lists = r_cut.size();
+
+		bool wr = in_cell(cli,r_max);
+
+		if (opt == VL_SYMMETRIC && wr == false)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error the symmetric construction require a cut-off radius smaller than the cell spacing" << std::endl;
+			return;
+		}
+
+		// the radius neighborhood is cached by the cell-list, it is resolved before the parallel traversal
+
+		const openfpm::vector<long int> & NNc = cli.getNNcRadius(r_max);
+
+		auto nn = [&](size_t i, auto add)
+		{
+			Point<dim,T> xp = pos.template get<0>(i);
+
+			auto test = [&](size_t q)
+			{
+				T d2 = xp.distance2(pos2.template get<0>(q));
+
+				for (size_t k = 0 ; k < n_lists ; k++)
+				{
+					if (d2 < r_cut2[k] && sel(k,i,q))
+					{add(k,q);}
+				}
+			};
+
+			if (opt == VL_SYMMETRIC)
+			{
+				auto NN = cli.template getNNIteratorSym<NO_CHECK>(cli.getCell(xp),i,pos);
+				while (NN.isNext())
+				{
+					test(NN.get());
+					++NN;
+				}
+			}
+			else if (wr == true)
+			{
+				auto NN = cli.template getNNIterator<NO_CHECK>(cli.getCell(xp));
+				while (NN.isNext())
+				{
+					test(NN.get());
+					++NN;
+				}
+			}
+			else
+			{
+				auto NN = cli.template getNNIteratorRadius<NO_CHECK>(cli.getCell(xp),NNc);
+				while (NN.isNext())
+				{
+					test(NN.get());
+					++NN;
+				}
+			}
+		};
+
+		create(n_lists,g_m,nn);
+	}
+
+	/*! \brief Initialize the lists of the phase pairs (pp,v) from a Multi-Phase Cell-list
+	 *
+	 * The list v contain the neighborhood particles of the phase v (without the phase
+	 * encoding) closer than r_cut[v]
+	 *
+	 * \param cli external Multi-Phase Cell-list
+	 * \param pp phase of pos
+	 * \param r_cut cut-off radius for every phase of the neighborhood
+	 * \param pos vector of particle positions
+	 * \param pos2 vector of particle position of every phase
+	 * \param g_m Indicate form which particles to construct the verlet lists
+	 * \param opt options for the Verlet-list creation (VL_NON_SYMMETRIC or VL_SYMMETRIC)
+	 *
+	 */
+	template<unsigned int sh_byte, typename CellBase, typename vector_pos_type>
+	void InitializeM(CellListM<dim,T,sh_byte,CellBase> & cli,
+			         size_t pp,
+			         const openfpm::vector<T> & r_cut,
+			         const vector_pos_type & pos,
+			         const openfpm::vector<pos_v<vector_pos_type>> & pos2,
+			         size_t g_m,
+			         size_t opt = VL_NON_SYMMETRIC)
+	{
+		std::vector<T> r_cut2;
+		T r_max = max_r_cut(r_cut,r_cut2);
+
+		if (in_cell(cli,r_max) == false)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error iterator with radius is not implemented yet " << std::endl;
+			return;
+		}
+
+		auto nn = [&](size_t i, auto add)
+		{
+			Point<dim,T> xp = pos.template get<0>(i);
+
+			auto test = [&](size_t v, size_t q)
+			{
+				if (v >= r_cut2.size())	{return;}
+
+				if (xp.distance2(pos2.get(v).pos.template get<0>(q)) < r_cut2[v])
+				{add(v,q);}
+			};
+
+			if (opt == VL_SYMMETRIC)
+			{
+				auto NN = cli.template getNNIteratorSym<NO_CHECK>(cli.getCell(xp),pp,i,pos,pos2);
+				while (NN.isNext())
+				{
+					test(NN.getV(),NN.getP());
+					++NN;
+				}
+			}
+			else
+			{
+				auto NN = cli.template getNNIterator<NO_CHECK>(cli.getCell(xp));
+				while (NN.isNext())
+				{
+					test(NN.getV(),NN.getP());
+					++NN;
+				}
+			}
+		};
+
+		create(r_cut.size(),g_m,nn);
+	}
+
+	/*! \brief Return the number of lists
+	 *
+	 * \return the number of lists
+	 *
+	 */
+	size_t size() const
+	{
+		return vl.size();
+	}
+
+	/*! \brief Return the Verlet-list k
+	 *
+	 * \param k list
+	 *
+	 * \return the Verlet-list
+	 *
+	 */
+	VerletBase & getList(size_t k)
+	{
+		return vl[k];
+	}
+
+	/*! \brief Return the Verlet-list k
+	 *
+	 * \param k list
+	 *
+	 * \return the Verlet-list
+	 *
+	 */
+	const VerletBase & getList(size_t k) const
+	{
+		return vl[k];
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETLISTMULTI_HPP_ */
@@ -0,0 +1,185 @@
+/*
+ * VerletListMulti_unit_tests.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include "NN/VerletList/VerletListMulti.hpp"
+
+BOOST_AUTO_TEST_SUITE( VerletListMulti_test )
+
+/*! \brief Check one list against the brute force neighborhood
+ *
+ * \param vl Verlet-list
+ * \param pos particle positions
+ * \param pos2 neighborhood positions
+ * \param g_m number of particles with a list
+ * \param r_cut cut-off radius
+ * \param sel pair selector
+ *
+ * \return true if the list is correct
+ *
+ */
+template<typename VerletList_type, typename sel_type>
+bool check_list(VerletList_type & vl, const openfpm::vector<Point<3,double>> & pos,
+		        const openfpm::vector<Point<3,double>> & pos2, size_t g_m, double r_cut, sel_type sel)
+{
+	bool ret = true;
+
+	for (size_t i = 0 ; i < g_m ; i++)
+	{
+		openfpm::vector<size_t> nn_bf;
+		for (size_t j = 0 ; j < pos2.size() ; j++)
+		{
+			if (Point<3,double>(pos.get(i)).distance2(Point<3,double>(pos2.get(j))) < r_cut*r_cut && sel(i,j))
+			{nn_bf.add(j);}
+		}
+
+		openfpm::vector<size_t> nn_vl;
+		for (size_t j = 0 ; j < vl.getNNPart(i) ; j++)
+		{nn_vl.add(vl.get(i,j));}
+
+		nn_bf.sort();
+		nn_vl.sort();
+
+		ret &= (nn_bf.size() == nn_vl.size());
+		for (size_t j = 0 ; j < nn_bf.size() && j < nn_vl.size() ; j++)
+		{ret &= (nn_bf.get(j) == nn_vl.get(j));}
+	}
+
+	return ret;
+}
+
+//! Species selector, the list 2 contain only pairs of the same species
+struct same_species
+{
+	inline bool operator()(size_t k, size_t p, size_t q) const
+	{
+		return k != 2 || (p % 2) == (q % 2);
+	}
+};
+
+/*! \brief Check the lists with several cut-off radius against the brute force neighborhood
+ *
+ * \param n_part number of particles
+ *
+ */
+void test_multi_cutoff(size_t n_part)
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {10,10,10};
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<double> ud(0.0,1.0);
+
+	openfpm::vector<Point<3,double>> pos;
+	for (size_t i = 0 ; i < n_part ; i++)
+	{pos.add(Point<3,double>({ud(eg),ud(eg),ud(eg)}));}
+
+	CellList<3,double,Mem_fast<>,shift<3,double>> cl;
+	cl.Initialize(box,div,2);
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{cl.add(pos.get(i),i);}
+
+	openfpm::vector<double> r_cut;
+	r_cut.add(0.05);
+	r_cut.add(0.1);
+	r_cut.add(0.08);
+
+	size_t g_m = n_part - n_part / 6;
+
+	VerletListMulti<3,double> vlm;
+	vlm.Initialize(cl,r_cut,pos,pos,g_m,same_species());
+
+	BOOST_REQUIRE_EQUAL(vlm.size(),3ul);
+
+	auto all = [](size_t p, size_t q){return true;};
+	auto ss = [](size_t p, size_t q){return (p % 2) == (q % 2);};
+
+	BOOST_REQUIRE_EQUAL(check_list(vlm.getList(0),pos,pos,g_m,0.05,all),true);
+	BOOST_REQUIRE_EQUAL(check_list(vlm.getList(1),pos,pos,g_m,0.1,all),true);
+	BOOST_REQUIRE_EQUAL(check_list(vlm.getList(2),pos,pos,g_m,0.08,ss),true);
+
+	// cut-off radius bigger than the cell spacing, the radius iterator is used
+
+	r_cut.get(1) = 0.15;
+
+	VerletListMulti<3,double> vlm2;
+	vlm2.Initialize(cl,r_cut,pos,pos,g_m);
+
+	BOOST_REQUIRE_EQUAL(check_list(vlm2.getList(0),pos,pos,g_m,0.05,all),true);
+	BOOST_REQUIRE_EQUAL(check_list(vlm2.getList(1),pos,pos,g_m,0.15,all),true);
+	BOOST_REQUIRE_EQUAL(check_list(vlm2.getList(2),pos,pos,g_m,0.08,all),true);
+}
+
+BOOST_AUTO_TEST_CASE( VerletListMulti_multi_cutoff )
+{
+	test_multi_cutoff(3000);
+}
+
+BOOST_AUTO_TEST_CASE( VerletListMulti_multi_cutoff_threads )
+{
+	// with a small grain the lists are constructed by several threads and the
+	// private buffers are joined
+
+	size_t grain = openfpm::cpu_parallel_grain();
+	openfpm::cpu_parallel_grain() = 256;
+
+	test_multi_cutoff(3000);
+	test_multi_cutoff(5*256 + 17);
+
+	openfpm::cpu_parallel_grain() = grain;
+}
+
+BOOST_AUTO_TEST_CASE( VerletListMulti_phases )
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {10,10,10};
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<double> ud(0.0,1.0);
+
+	openfpm::vector<Point<3,double>> ps1;
+	openfpm::vector<Point<3,double>> ps2;
+
+	for (size_t i = 0 ; i < 2000 ; i++)
+	{ps1.add(Point<3,double>({ud(eg),ud(eg),ud(eg)}));}
+
+	for (size_t i = 0 ; i < 1000 ; i++)
+	{ps2.add(Point<3,double>({ud(eg),ud(eg),ud(eg)}));}
+
+	openfpm::vector<pos_v<openfpm::vector<Point<3,double>>>> pos2;
+	pos2.add(pos_v<openfpm::vector<Point<3,double>>>(ps1));
+	pos2.add(pos_v<openfpm::vector<Point<3,double>>>(ps2));
+
+	CellListM<3,double,2> cl;
+	cl.Initialize(box,div,2);
+
+	for (size_t i = 0 ; i < ps1.size() ; i++)
+	{cl.add(ps1.get(i),i,0);}
+
+	for (size_t i = 0 ; i < ps2.size() ; i++)
+	{cl.add(ps2.get(i),i,1);}
+
+	// lists of the phase pairs (0,0) and (0,1)
+
+	openfpm::vector<double> r_cut;
+	r_cut.add(0.1);
+	r_cut.add(0.07);
+
+	VerletListMulti<3,double> vlm;
+	vlm.InitializeM(cl,0,r_cut,ps1,pos2,ps1.size());
+
+	auto all = [](size_t p, size_t q){return true;};
+
+	BOOST_REQUIRE_EQUAL(vlm.size(),2ul);
+	BOOST_REQUIRE_EQUAL(check_list(vlm.getList(0),ps1,ps1,ps1.size(),0.1,all),true);
+	BOOST_REQUIRE_EQUAL(check_list(vlm.getList(1),ps1,ps2,ps1.size(),0.07,all),true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
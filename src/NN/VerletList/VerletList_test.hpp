@@ -10,6 +10,7 @@
 
 #include "NN/VerletList/VerletList.hpp"
 #include "NN/VerletList/VerletListM.hpp"
+#include <random>
 
 /*! \brief create a vector of particles on a grid between 0.0 and 1.0
  *
@@ -473,6 +474,270 @@ template<unsigned int dim, typename T, typename VerS> void Verlet_list_sM(SpaceB
 }
 
 
+/*! \brief Check that the Verlet-list constructed with the CSR memory is identical to the one
+ *         constructed with Mem_fast and that it contain all and only the particles within r_cut
+ *
+ * \param opt VL_NON_SYMMETRIC or VL_SYMMETRIC
+ *
+ */
+void Verlet_list_csr(size_t opt)
+{
+	SpaceBox<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	double r_cut = 0.1;
+
+	openfpm::vector<Point<3,double>> pos;
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<double> ud(0.0,1.0);
+
+	for (size_t i = 0 ; i < 5000 ; i++)
+	{
+		pos.add(Point<3,double>({ud(eg),ud(eg),ud(eg)}));
+	}
+
+	VerletList<3,double,Mem_fast<HeapMemory,local_index_>> vl1;
+	VerletList<3,double,Mem_compact<HeapMemory,local_index_>> vl2;
+
+	vl1.Initialize(box,box,r_cut,pos,pos.size(),opt);
+	vl2.Initialize(box,box,r_cut,pos,pos.size(),opt);
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{
+		BOOST_REQUIRE_EQUAL(vl1.getNNPart(i),vl2.getNNPart(i));
+
+		for (size_t j = 0 ; j < vl1.getNNPart(i) ; j++)
+		{BOOST_REQUIRE_EQUAL(vl1.get(i,j),vl2.get(i,j));}
+
+		if (opt == VL_NON_SYMMETRIC)
+		{
+			size_t n_nn = 0;
+
+			for (size_t j = 0 ; j < pos.size() ; j++)
+			{
+				if (Point<3,double>(pos.get(i)).distance2(pos.get(j)) < r_cut*r_cut)
+				{n_nn++;}
+			}
+
+			BOOST_REQUIRE_EQUAL(vl2.getNNPart(i),n_nn);
+		}
+	}
+}
+
+/*! \brief Check the Verlet-list constructed in parallel from an external Cell-list with cells
+ *         smaller than the cut-off radius (neighborhood with radius) against a brute force search
+ *
+ */
+void Verlet_list_radius()
+{
+	SpaceBox<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	double r_cut = 0.12;
+
+	openfpm::vector<Point<3,double>> pos;
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<double> ud(0.0,1.0);
+
+	for (size_t i = 0 ; i < 5000 ; i++)
+	{
+		pos.add(Point<3,double>({ud(eg),ud(eg),ud(eg)}));
+	}
+
+	// cells of 0.05, the neighborhood span 3 cells in each direction
+
+	size_t div[3] = {20,20,20};
+	CellList<3,double,Mem_fast<HeapMemory,local_index_>> cli;
+	cli.Initialize(box,div,3);
+	cli.fill(pos,pos.size());
+
+	VerletList<3,double> vl;
+	vl.Initialize(cli,r_cut,pos,pos,pos.size());
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{
+		openfpm::vector<size_t> nn;
+
+		for (size_t j = 0 ; j < vl.getNNPart(i) ; j++)
+		{nn.add(vl.get(i,j));}
+
+		openfpm::vector<size_t> nn_ref;
+
+		for (size_t j = 0 ; j < pos.size() ; j++)
+		{
+			if (Point<3,double>(pos.get(i)).distance2(pos.get(j)) < r_cut*r_cut)
+			{nn_ref.add(j);}
+		}
+
+		nn.sort();
+
+		BOOST_REQUIRE_EQUAL(nn.size(),nn_ref.size());
+
+		for (size_t j = 0 ; j < nn.size() ; j++)
+		{BOOST_REQUIRE_EQUAL(nn.get(j),nn_ref.get(j));}
+	}
+}
+
+/*! \brief Check the CRS Verlet-list constructed in parallel, every pair of different particles
+ *         within r_cut must appear exactly once
+ *
+ */
+void Verlet_list_crs()
+{
+	SpaceBox<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	double r_cut = 0.1;
+	Ghost<3,double> g(r_cut);
+
+	openfpm::vector<Point<3,double>> pos;
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<double> ud(0.0,1.0);
+
+	for (size_t i = 0 ; i < 5000 ; i++)
+	{
+		pos.add(Point<3,double>({ud(eg),ud(eg),ud(eg)}));
+	}
+
+	VerletList<3,double,Mem_fast<HeapMemory,local_index_>,shift<3,double>> vl;
+	vl.InitializeCrs(box,box,g,r_cut,pos,pos.size());
+
+	// all the domain cells have a normal neighborhood
+
+	auto & cli = vl.getInternalCellList();
+	const grid_sm<3,void> & gs = cli.getGrid();
+
+	grid_key_dx<3> start;
+	grid_key_dx<3> stop;
+
+	for (size_t i = 0 ; i < 3 ; i++)
+	{
+		start.set_d(i,cli.getPadding(i));
+		stop.set_d(i,gs.size(i) - cli.getPadding(i) - 1);
+	}
+
+	openfpm::vector<size_t> dom_c;
+	openfpm::vector<subsub_lin<3>> anom_c;
+
+	grid_key_dx_iterator_sub<3> it(gs,start,stop);
+
+	while (it.isNext())
+	{
+		dom_c.add(gs.LinId(it.get()));
+		++it;
+	}
+
+	vl.createVerletCrs(r_cut,pos.size(),pos,dom_c,anom_c);
+
+	openfpm::vector<aggregate<size_t,size_t>> pairs;
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{
+		for (size_t j = 0 ; j < vl.getNNPart(i) ; j++)
+		{
+			size_t q = vl.get(i,j);
+
+			// the symmetric neighborhood include the particle itself
+			if (q == i)	{continue;}
+
+			BOOST_REQUIRE((Point<3,double>(pos.get(i)).distance2(pos.get(q)) < r_cut*r_cut));
+
+			pairs.add();
+			pairs.last().template get<0>() = std::min(i,q);
+			pairs.last().template get<1>() = std::max(i,q);
+		}
+	}
+
+	size_t n_pairs = 0;
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{
+		for (size_t j = i+1 ; j < pos.size() ; j++)
+		{
+			if (Point<3,double>(pos.get(i)).distance2(pos.get(j)) < r_cut*r_cut)
+			{n_pairs++;}
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(pairs.size(),n_pairs);
+
+	std::vector<std::pair<size_t,size_t>> srt(pairs.size());
+
+	for (size_t k = 0 ; k < pairs.size() ; k++)
+	{srt[k] = std::make_pair(pairs.template get<0>(k),pairs.template get<1>(k));}
+
+	std::sort(srt.begin(),srt.end());
+
+	for (size_t k = 1 ; k < srt.size() ; k++)
+	{BOOST_REQUIRE(srt[k-1] != srt[k]);}
+}
+
+/*! \brief Check that the Verlet-list with skin is reconstructed only when needed and
+ *         that between two reconstructions it contain all the particles within r_cut
+ *
+ */
+void Verlet_list_skin()
+{
+	SpaceBox<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	double r_cut = 0.1;
+	double skin = 0.02;
+
+	openfpm::vector<Point<3,double>> pos;
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<double> ud(0.0,1.0);
+	std::uniform_real_distribution<double> ud_move(-1.0,1.0);
+
+	for (size_t i = 0 ; i < 3000 ; i++)
+	{
+		pos.add(Point<3,double>({0.1 + 0.8*ud(eg),0.1 + 0.8*ud(eg),0.1 + 0.8*ud(eg)}));
+	}
+
+	VerletList<3,double> vl;
+	vl.InitializeSkin(box,box,r_cut,skin,pos,pos.size());
+
+	BOOST_REQUIRE_EQUAL(vl.needRebuild(pos),false);
+
+	size_t n_rebuild = 0;
+
+	for (size_t step = 0 ; step < 10 ; step++)
+	{
+		// every particle move at most 0.003 in each direction
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{
+			for (size_t j = 0 ; j < 3 ; j++)
+			{pos.template get<0>(i)[j] += 0.003*ud_move(eg);}
+		}
+
+		n_rebuild += (vl.updateSkin(pos,pos.size()) == true)?1:0;
+
+		BOOST_REQUIRE_EQUAL(vl.needRebuild(pos),false);
+
+		// the list must contain all the particles within r_cut
+		for (size_t i = 0 ; i < pos.size() ; i += 7)
+		{
+			size_t n_in = 0;
+			for (size_t j = 0 ; j < vl.getNNPart(i) ; j++)
+			{
+				if (Point<3,double>(pos.get(i)).distance2(pos.get(vl.get(i,j))) < r_cut*r_cut)
+				{n_in++;}
+			}
+
+			size_t n_nn = 0;
+			for (size_t j = 0 ; j < pos.size() ; j++)
+			{
+				if (Point<3,double>(pos.get(i)).distance2(pos.get(j)) < r_cut*r_cut)
+				{n_nn++;}
+			}
+
+			BOOST_REQUIRE_EQUAL(n_in,n_nn);
+		}
+	}
+
+	// max displacement per step is 0.003*sqrt(3) the list can survive at least 1 step
+	// and must be reconstructed at least once in 10 steps
+
+	BOOST_REQUIRE(n_rebuild >= 1);
+	BOOST_REQUIRE(n_rebuild < 10);
+}
+
 BOOST_AUTO_TEST_SUITE( VerletList_test )
 
 BOOST_AUTO_TEST_CASE( VerletList_use)
@@ -491,6 +756,19 @@ BOOST_AUTO_TEST_CASE( VerletList_use)
 	// Test the cell list
 }
 
+BOOST_AUTO_TEST_CASE( VerletList_csr_parallel )
+{
+	Verlet_list_csr(VL_NON_SYMMETRIC);
+	Verlet_list_csr(VL_SYMMETRIC);
+	Verlet_list_radius();
+	Verlet_list_crs();
+}
+
+BOOST_AUTO_TEST_CASE( VerletList_skin )
+{
+	Verlet_list_skin();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -2216,11 +2216,9 @@ public:
 
 		openfpm::vector<cheader<dim>> header_inf_tmp;
 		openfpm::vector<mheader<chunking::size::value>> header_mask_tmp;
-		openfpm::vector<aggregate_bfv<chunk_def>,S,layout_base > chunks_tmp;
 
 		header_inf_tmp.resize(n_chunks);
 		header_mask_tmp.resize(n_chunks);
-		chunks_tmp.resize(n_chunks);
 
 		for (size_t i = 0 ; i < n_chunks ; i++)
 		{
@@ -2328,11 +2326,9 @@ public:
 
 		openfpm::vector<cheader<dim>> header_inf_tmp;
 		openfpm::vector<mheader<chunking::size::value>> header_mask_tmp;
-		openfpm::vector<aggregate_bfv<chunk_def>> chunks_tmp;
 
 		header_inf_tmp.resize(n_chunks);
 		header_mask_tmp.resize(n_chunks);
-		chunks_tmp.resize(n_chunks);
 
 		for (size_t i = 0 ; i < n_chunks ; i++)
 		{
@@ -40,6 +40,9 @@
 #include "util/cuda_util.hpp"
 #include "cuda/map_vector_cuda_ker.cuh"
 #include "map_vector_printers.hpp"
+#include "map_vector_compact.hpp"
+#include "map_vector_permute.hpp"
+#include "map_vector_gather.hpp"
 
 namespace openfpm
 {
@@ -239,6 +242,162 @@ namespace openfpm
 
 #endif
 
+		/*! \brief Remove several entries from the vector, bulk compaction
+		 *
+		 * \param keys objects id to remove (sorted)
+		 * \param start key starting point
+		 *
+		 */
+		void remove_impl(openfpm::vector<size_t> & keys, size_t start, std::true_type)
+		{
+			std::vector<unsigned char> keep(size(),1);
+
+			#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(keys.size() - start)) schedule(static)
+			for (size_t k = start ; k < keys.size() ; k++)
+			{
+				if (keys.get(k) < keep.size())
+				{keep[keys.get(k)] = 0;}
+			}
+
+			openfpm::vector_compact(*this,size(),keep.data());
+		}
+
+		/*! \brief Remove several entries from the vector, moving the objects one by one
+		 *
+		 * \param keys objects id to remove (sorted)
+		 * \param start key starting point
+		 *
+		 */
+		void remove_impl(openfpm::vector<size_t> & keys, size_t start, std::false_type)
+		{
+			size_t a_key = start;
+			size_t d_k = keys.get(a_key);
+			size_t s_k = keys.get(a_key) + 1;
+
+			// keys
+			while (s_k < size())
+			{
+				// s_k should always point to a key that is not going to be deleted
+				while (a_key+1 < keys.size() && s_k == keys.get(a_key+1))
+				{
+					a_key++;
+					s_k = keys.get(a_key) + 1;
+				}
+
+				// In case of overflow
+				if (s_k >= size())
+					break;
+
+				set(d_k,get(s_k));
+				d_k++;
+				s_k++;
+			}
+		}
+
+		/*! \brief Compact the vector keeping the flagged elements, bulk compaction
+		 *
+		 * \param keep flag for every element
+		 *
+		 * \return the number of kept elements
+		 *
+		 */
+		size_t remove_if_impl(const unsigned char * keep, std::true_type)
+		{
+			return openfpm::vector_compact(*this,size(),keep);
+		}
+
+		/*! \brief Compact the vector keeping the flagged elements, moving the objects one by one
+		 *
+		 * \param keep flag for every element
+		 *
+		 * \return the number of kept elements
+		 *
+		 */
+		size_t remove_if_impl(const unsigned char * keep, std::false_type)
+		{
+			size_t d_k = 0;
+
+			for (size_t s_k = 0 ; s_k < size() ; s_k++)
+			{
+				if (keep[s_k] == 0)	{continue;}
+
+				if (d_k != s_k)
+				{set(d_k,get(s_k));}
+
+				d_k++;
+			}
+
+			return d_k;
+		}
+
+		/*! \brief Apply the permutation of sort_by, bulk gather
+		 *
+		 * \param perm permutation
+		 *
+		 */
+		void sort_by_impl(const size_t * perm, std::true_type)
+		{
+			openfpm::vector_permute(*this,size(),perm);
+		}
+
+		/*! \brief Apply the permutation of sort_by, the objects cannot be moved as raw memory
+		 *
+		 * \param perm permutation
+		 *
+		 */
+		void sort_by_impl(const size_t * perm, std::false_type)
+		{
+			self_type tmp;
+			tmp.resize(size());
+
+			#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(size())) schedule(static)
+			for (size_t i = 0 ; i < size() ; i++)
+			{tmp.set(i,*this,perm[i]);}
+
+			swap(tmp);
+		}
+
+		/*! \brief Copy with indirect addressing the selected properties, bulk copy
+		 *
+		 * \tparam is_scatter false: dst[i] = src[idx[i]], true: dst[idx[i]] = src[i]
+		 * \tparam prp selected properties (all if none)
+		 *
+		 * \param dst destination vector
+		 * \param src source vector
+		 * \param idx indexes
+		 * \param n number of indexes
+		 *
+		 */
+		template<bool is_scatter, unsigned int ... prp>
+		static void gather_impl(self_type & dst, self_type & src, const size_t * idx, size_t n, std::true_type)
+		{
+			openfpm::vector_gather<is_scatter,prp...>(dst,src,idx,n);
+		}
+
+		/*! \brief Copy with indirect addressing the selected properties, the objects cannot be moved as raw memory
+		 *
+		 * \tparam is_scatter false: dst[i] = src[idx[i]], true: dst[idx[i]] = src[i]
+		 * \tparam prp selected properties (all if none)
+		 *
+		 * \param dst destination vector
+		 * \param src source vector
+		 * \param idx indexes
+		 * \param n number of indexes
+		 *
+		 */
+		template<bool is_scatter, unsigned int ... prp>
+		static void gather_impl(self_type & dst, self_type & src, const size_t * idx, size_t n, std::false_type)
+		{
+			#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(n)) schedule(static)
+			for (size_t i = 0 ; i < n ; i++)
+			{
+				size_t d = (is_scatter == true)?idx[i]:i;
+				size_t s = (is_scatter == true)?i:idx[i];
+
+				openfpm::gather_set_impl<sizeof...(prp) == 0,prp...>::set(dst,d,src,s);
+			}
+		}
+
 	public:
 
 		//! it define that it is a vector
@@ -1054,6 +1213,10 @@ namespace openfpm
 		}
 
 		/*! \brief Remove several entries from the vector
+		 *
+		 * When the properties are trivially copyable the vector is compacted in parallel
+		 * moving contiguous runs of objects with memmove (one buffer per property for
+		 * memory_traits_inte), otherwise the objects are moved one by one
 		 *
 		 * \warning the keys in the vector MUST be sorted
 		 *
@@ -1067,32 +1230,165 @@ namespace openfpm
 			if (keys.size() <= start )
 				return;
 
-			size_t a_key = start;
-			size_t d_k = keys.get(a_key);
-			size_t s_k = keys.get(a_key) + 1;
+			remove_impl(keys,start,std::integral_constant<bool,vector_compact_bulk<self_type>::value>());
 
-			// keys
-			while (s_k < size())
+			// re-calculate the vector size
+
+			v_size -= keys.size() - start;
+		}
+
+		/*! \brief Remove all the entries for which the predicate return true
+		 *
+		 * The predicate is called once for every element, in parallel, it must be thread safe.
+		 * The order of the remaining elements is preserved
+		 *
+		 * \param pred predicate pred(i) return true if the element i must be removed
+		 *
+		 */
+		template<typename pred_type>
+		void remove_if(pred_type pred)
+		{
+			size_t n = size();
+			std::vector<unsigned char> keep(n);
+
+			#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(n)) schedule(static)
+			for (size_t i = 0 ; i < n ; i++)
+			{keep[i] = !pred(i);}
+
+			v_size = remove_if_impl(keep.data(),std::integral_constant<bool,vector_compact_bulk<self_type>::value>());
+		}
+
+		/*! \brief Sort the vector by the property prp
+		 *
+		 * The keys are sorted with a parallel stable LSD radix sort, the resulting permutation
+		 * is applied to all the properties, with a gather for every property buffer
+		 * (memory_traits_inte) or for the whole objects (memory_traits_lin)
+		 *
+		 * \tparam prp key property (integer or floating point)
+		 *
+		 * \param perm permutation (output), the element i of the sorted vector was the element perm.get(i)
+		 * \param descending true to sort in descending order
+		 *
+		 */
+		template<unsigned int prp>
+		void sort_by(openfpm::vector<size_t> & perm, bool descending = false)
+		{
+			typedef typename boost::mpl::at<typename T::type,boost::mpl::int_<prp>>::type key_type;
+
+			static_assert(openfpm::is_radix_sortable<key_type>::value,"sort_by require an integer (not bool) or floating point key property");
+
+			size_t n = size();
+			perm.resize(n);
+
+			if (n == 0)	{return;}
+
+			std::vector<key_type> keys(n);
+			std::vector<key_type> keys_tmp(n);
+			std::vector<size_t> perm_tmp(n);
+
+			#pragma omp parallel for num_threads(openfpm::cpu_num_threads_for(n)) schedule(static)
+			for (size_t i = 0 ; i < n ; i++)
 			{
-				// s_k should always point to a key that is not going to be deleted
-				while (a_key+1 < keys.size() && s_k == keys.get(a_key+1))
-				{
-					a_key++;
-					s_k = keys.get(a_key) + 1;
-				}
+				keys[i] = this->template get<prp>(i);
+				perm.get(i) = i;
+			}
 
-				// In case of overflow
-				if (s_k >= size())
-					break;
+			openfpm::cpu_radix_sort_pairs(keys.data(),&perm.get(0),n,keys_tmp.data(),perm_tmp.data(),descending);
 
-				set(d_k,get(s_k));
-				d_k++;
-				s_k++;
+			sort_by_impl(&perm.get(0),std::integral_constant<bool,vector_compact_bulk<self_type>::value>());
+		}
+
+		/*! \brief Sort the vector by the property prp
+		 *
+		 * \see sort_by(perm,descending)
+		 *
+		 * \tparam prp key property (integer or floating point)
+		 *
+		 * \param descending true to sort in descending order
+		 *
+		 */
+		template<unsigned int prp>
+		void sort_by(bool descending = false)
+		{
+			openfpm::vector<size_t> perm;
+			sort_by<prp>(perm,descending);
+		}
+
+		/*! \brief Fill this vector with the elements of src selected by an index list
+		 *
+		 * After the call the vector has size idx.size() and the element i is a copy of the element
+		 * idx.get(i) of src. When the properties are trivially copyable every property buffer
+		 * (memory_traits_inte) or every property field (memory_traits_lin) is copied with a
+		 * prefetched gather in parallel, otherwise the objects are copied one by one
+		 *
+		 * \tparam prp properties to copy (all if none is specified)
+		 *
+		 * \param src source vector (it can be this vector)
+		 * \param idx indexes of the elements of src
+		 *
+		 */
+		template<unsigned int ... prp>
+		void gather(vector<T,Memory,layout_base,grow_p,OPENFPM_NATIVE> & src, const openfpm::vector<size_t> & idx)
+		{
+			// this vector is resized and overwritten while src is read, gather from a copy
+
+			if (&src == this)
+			{
+				self_type src_cp(src);
+				gather<prp...>(src_cp,idx);
+				return;
 			}
 
-			// re-calculate the vector size
+			resize(idx.size());
 
-			v_size -= keys.size() - start;
+			if (idx.size() == 0)	{return;}
+
+#ifdef SE_CLASS1
+			for (size_t i = 0 ; i < idx.size() ; i++)
+			{src.check_overflow(idx.get(i));}
+#endif
+
+			gather_impl<false,prp...>(*this,src,&idx.get(0),idx.size(),std::integral_constant<bool,vector_compact_bulk<self_type>::value>());
+		}
+
+		/*! \brief Copy the elements of this vector into dst at the positions given by an index list
+		 *
+		 * The element i is copied into the element idx.get(i) of dst. dst is not resized
+		 *
+		 * \warning the indexes must be unique, the elements are written in parallel
+		 *
+		 * \tparam prp properties to copy (all if none is specified)
+		 *
+		 * \param dst destination vector (it can be this vector)
+		 * \param idx indexes of the elements of dst (at least size() indexes)
+		 *
+		 */
+		template<unsigned int ... prp>
+		void scatter(vector<T,Memory,layout_base,grow_p,OPENFPM_NATIVE> & dst, const openfpm::vector<size_t> & idx)
+		{
+			if (size() == 0)	{return;}
+
+			// dst is overwritten while this vector is read, scatter from a copy
+
+			if (&dst == this)
+			{
+				self_type src_cp(*this);
+				src_cp.template scatter<prp...>(dst,idx);
+				return;
+			}
+
+#ifdef SE_CLASS1
+			if (idx.size() < size())
+			{
+				std::cerr << "Error " << __FILE__ << ":" << __LINE__ << " scatter of " << size() << " elements with only " << idx.size() << " indexes" << "\n";
+				ACTION_ON_ERROR(VECTOR_ERROR_OBJECT);
+			}
+
+			for (size_t i = 0 ; i < size() ; i++)
+			{dst.check_overflow(idx.get(i));}
+#endif
+
+			gather_impl<true,prp...>(dst,*this,&idx.get(0),size(),std::integral_constant<bool,vector_compact_bulk<self_type>::value>());
 		}
 
 		/*! \brief Get an element of the vector
@@ -1396,6 +1692,24 @@ namespace openfpm
 			base.set(id,v.base,src);
 		}
 
+		/*! \brief Set only some properties of the element of the vector v from another element of another vector
+		 *
+		 * \tparam prp properties to copy
+		 *
+		 * \param id element id
+		 * \param v vector source
+		 * \param src source element
+		 *
+		 */
+		template<unsigned int ... prp>
+		void set(size_t id, const vector<T,Memory,layout_base,grow_p,OPENFPM_NATIVE> & v, size_t src)
+		{
+#ifdef SE_CLASS1
+			check_overflow(id);
+#endif
+			base.template set<prp ...>(grid_key_dx<1>(id),v.base,grid_key_dx<1>(src));
+		}
+
 
 		/*! \brief Assignment operator
 		 *
@@ -0,0 +1,308 @@
+/*
+ * map_vector_compact.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_COMPACT_HPP_
+#define OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_COMPACT_HPP_
+
+#include <vector>
+#include <cstring>
+#include <type_traits>
+#include <boost/mpl/at.hpp>
+#include <boost/mpl/size.hpp>
+#include <boost/mpl/range_c.hpp>
+#include "util/for_each_ref.hpp"
+#include "util/cpu_parallel_util.hpp"
+#include "memory_ly/memory_conf.hpp"
+
+namespace openfpm
+{
+	/*! \brief Check that all the types of a list can be copied with memmove
+	 *
+	 * \tparam prp list of types
+	 *
+	 */
+	template<typename ... prp>
+	struct compact_all_trivially_copyable
+	{
+		static const bool value = true;
+	};
+
+	//! Check the first type of the list and go on with the others
+	template<typename p1, typename ... prp>
+	struct compact_all_trivially_copyable<p1,prp...>
+	{
+		static const bool value = std::is_trivially_copyable<typename std::remove_all_extents<p1>::type>::value &&
+				                  compact_all_trivially_copyable<prp...>::value;
+	};
+
+	/*! \brief Check if the properties T::type of an object can be moved with memmove
+	 *
+	 * \tparam T boost::fusion::vector of properties
+	 *
+	 */
+	template<typename T>
+	struct compact_is_movable
+	{
+		static const bool value = false;
+	};
+
+	//! boost::fusion::vector of properties
+	template<typename ... prp>
+	struct compact_is_movable<boost::fusion::vector<prp...>>
+	{
+		static const bool value = compact_all_trivially_copyable<prp...>::value;
+	};
+
+	/*! \brief Check if an openfpm::vector can be compacted moving raw memory
+	 *
+	 * The layout must be memory_traits_lin or memory_traits_inte and the properties
+	 * must be trivially copyable
+	 *
+	 * \tparam vector_type type of the vector
+	 *
+	 */
+	template<typename vector_type>
+	struct vector_compact_bulk
+	{
+		typedef typename vector_type::layout_base_ lb;
+
+		static const bool value = (is_layout_mlin<lb>::value || is_layout_inte<lb>::value) &&
+				                  compact_is_movable<typename vector_type::value_type::type>::value;
+	};
+
+	/*! \brief Contiguous memory block where the element i is at ptr + i*es
+	 *
+	 * A vector with memory_traits_lin has one block (the objects), with memory_traits_inte
+	 * has one block for every property and every component of the array properties
+	 * (the element index is the fastest)
+	 *
+	 */
+	struct compact_block
+	{
+		//! pointer to the element 0
+		unsigned char * ptr;
+
+		//! size of one element
+		size_t es;
+	};
+
+	/*! \brief For each property add the blocks of a vector with memory_traits_inte
+	 *
+	 * \tparam vector_type type of the vector
+	 *
+	 */
+	template<typename vector_type>
+	struct compact_blocks_prp
+	{
+		//! vector
+		vector_type & v;
+
+		//! blocks
+		std::vector<compact_block> & blk;
+
+		/*! \brief constructor
+		 *
+		 * \param v vector
+		 * \param blk blocks (output)
+		 *
+		 */
+		compact_blocks_prp(vector_type & v, std::vector<compact_block> & blk)
+		:v(v),blk(blk)
+		{}
+
+		//! It add the blocks of the property T::value
+		template<typename T>
+		inline void operator()(T& t)
+		{
+			typedef typename boost::mpl::at<typename vector_type::value_type::type,boost::mpl::int_<T::value>>::type prp_type;
+			typedef typename std::remove_all_extents<prp_type>::type base_type;
+
+			unsigned char * ptr = static_cast<unsigned char *>(v.template getPointer<T::value>());
+			size_t n_comp = sizeof(prp_type) / sizeof(base_type);
+
+			for (size_t c = 0 ; c < n_comp ; c++)
+			{blk.push_back(compact_block{ptr + c*v.capacity()*sizeof(base_type),sizeof(base_type)});}
+		}
+	};
+
+	/*! \brief Get the memory blocks of a vector
+	 *
+	 * \tparam is_inte true if the layout is memory_traits_inte
+	 *
+	 */
+	template<bool is_inte>
+	struct compact_blocks
+	{
+		template<typename vector_type>
+		static void get(vector_type & v, std::vector<compact_block> & blk)
+		{
+			blk.push_back(compact_block{static_cast<unsigned char *>(v.getPointer()),sizeof(typename vector_type::value_type::type)});
+		}
+	};
+
+	//! memory_traits_inte
+	template<>
+	struct compact_blocks<true>
+	{
+		template<typename vector_type>
+		static void get(vector_type & v, std::vector<compact_block> & blk)
+		{
+			typedef typename vector_type::value_type::type type;
+
+			compact_blocks_prp<vector_type> cb(v,blk);
+			boost::mpl::for_each_ref< boost::mpl::range_c<int,0,boost::mpl::size<type>::value> >(cb);
+		}
+	};
+
+	/*! \brief Compact in place the elements [0,n) of a set of blocks keeping the ones with keep[i] != 0
+	 *
+	 * The range is divided in one contiguous chunk per thread. The number of kept elements of every
+	 * chunk is scanned to get the destination of the chunk, then every thread move the runs of
+	 * kept elements with memmove. A thread write only under the end of its destination, the kept elements
+	 * of a chunk over that point can be overwritten by the following threads, so they are saved in
+	 * a private buffer before moving. The order of the kept elements is preserved
+	 *
+	 * \param blk memory blocks
+	 * \param n number of elements
+	 * \param keep flag for every element
+	 *
+	 * \return the number of kept elements
+	 *
+	 */
+	inline size_t compact_blocks_run(const std::vector<compact_block> & blk, size_t n, const unsigned char * keep)
+	{
+		if (n == 0)	{return 0;}
+
+		int nt = cpu_num_threads_for(n);
+
+		size_t el_sz = 0;
+		for (size_t b = 0 ; b < blk.size() ; b++)
+		{el_sz += blk[b].es;}
+
+		std::vector<size_t> dst(nt+1);
+		size_t n_keep = 0;
+
+		#pragma omp parallel num_threads(nt)
+		{
+			int t = cpu_thread_id();
+			int tsz = cpu_team_size();
+
+			size_t start;
+			size_t stop;
+			cpu_chunk(n,tsz,t,start,stop);
+
+			size_t cnt = 0;
+			for (size_t i = start ; i < stop ; i++)
+			{cnt += (keep[i] != 0);}
+
+			dst[t] = cnt;
+
+			#pragma omp barrier
+
+			#pragma omp single
+			{
+				size_t acc = 0;
+				for (int j = 0 ; j < tsz ; j++)
+				{
+					size_t c = dst[j];
+					dst[j] = acc;
+					acc += c;
+				}
+
+				dst[tsz] = acc;
+				n_keep = acc;
+			}
+
+			// the kept elements over the end of the destination are saved (never for the last thread)
+
+			size_t lim = (t == tsz - 1)?stop:dst[t+1];
+			lim = (lim < start)?start:((lim > stop)?stop:lim);
+
+			size_t n_save = 0;
+			for (size_t i = lim ; i < stop ; i++)
+			{n_save += (keep[i] != 0);}
+
+			std::vector<unsigned char> save(n_save*el_sz);
+
+			size_t off = 0;
+			for (size_t b = 0 ; b < blk.size() ; b++)
+			{
+				unsigned char * sv = save.data() + off*n_save;
+				size_t k = 0;
+
+				for (size_t i = lim ; i < stop ; i++)
+				{
+					if (keep[i] == 0)	{continue;}
+
+					std::memcpy(sv + k*blk[b].es,blk[b].ptr + i*blk[b].es,blk[b].es);
+					k++;
+				}
+
+				off += blk[b].es;
+			}
+
+			#pragma omp barrier
+
+			// move the runs of kept elements under lim
+
+			size_t d = dst[t];
+			size_t i = start;
+
+			while (i < lim)
+			{
+				if (keep[i] == 0)	{i++; continue;}
+
+				size_t r = i;
+				while (r < lim && keep[r] != 0)	{r++;}
+
+				if (d != i)
+				{
+					for (size_t b = 0 ; b < blk.size() ; b++)
+					{std::memmove(blk[b].ptr + d*blk[b].es,blk[b].ptr + i*blk[b].es,(r-i)*blk[b].es);}
+				}
+
+				d += r - i;
+				i = r;
+			}
+
+			// and the saved ones
+
+			off = 0;
+			for (size_t b = 0 ; b < blk.size() && n_save != 0 ; b++)
+			{
+				std::memcpy(blk[b].ptr + d*blk[b].es,save.data() + off*n_save,n_save*blk[b].es);
+				off += blk[b].es;
+			}
+		}
+
+		return n_keep;
+	}
+
+	/*! \brief Compact in place the elements [0,n) of a vector keeping the ones with keep[i] != 0
+	 *
+	 * It does not change the size of the vector
+	 *
+	 * \param v vector
+	 * \param n number of elements
+	 * \param keep flag for every element
+	 *
+	 * \return the number of kept elements
+	 *
+	 */
+	template<typename vector_type>
+	size_t vector_compact(vector_type & v, size_t n, const unsigned char * keep)
+	{
+		if (n == 0)	{return 0;}
+
+		std::vector<compact_block> blk;
+		compact_blocks<is_layout_inte<typename vector_type::layout_base_>::value>::get(v,blk);
+
+		return compact_blocks_run(blk,n,keep);
+	}
+}
+
+#endif /* OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_COMPACT_HPP_ */
@@ -0,0 +1,358 @@
+/*
+ * map_vector_gather.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_GATHER_HPP_
+#define OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_GATHER_HPP_
+
+#include <boost/mpl/vector_c.hpp>
+#include "Vector/map_vector_compact.hpp"
+
+namespace openfpm
+{
+	//! number of elements processed by a thread in one step
+	constexpr size_t gather_tile = 4096;
+
+	//! number of elements prefetched ahead
+	constexpr size_t gather_prefetch = 64;
+
+	/*! \brief Strided memory block where the element i is at ptr + i*stride and has size es
+	 *
+	 * With memory_traits_inte every component of a property is a dense block (stride == es),
+	 * with memory_traits_lin a property is a field of the objects (stride is the size of the object)
+	 *
+	 */
+	struct gather_block
+	{
+		//! pointer to the element 0
+		unsigned char * ptr;
+
+		//! size of one element
+		size_t es;
+
+		//! distance between two elements
+		size_t stride;
+	};
+
+	/*! \brief Word of es bytes that can alias any property
+	 *
+	 * \tparam es size of the word
+	 *
+	 */
+	template<unsigned int es>
+	struct gather_word
+	{
+		typedef unsigned long int __attribute__((may_alias)) type;
+	};
+
+	//! 4 bytes word
+	template<>
+	struct gather_word<4>
+	{
+		typedef unsigned int __attribute__((may_alias)) type;
+	};
+
+	/*! \brief Copy element by element between two blocks with indirect addressing
+	 *
+	 * \tparam es size of one element for dense blocks of 4 or 8 bytes elements, 0 otherwise
+	 *
+	 */
+	template<unsigned int es>
+	struct gather_kernel
+	{
+		//! type of one element
+		typedef typename gather_word<es>::type word;
+
+		/*! \brief dst[i] = src[idx[i]] for i in [start,stop)
+		 *
+		 * \param dst destination block
+		 * \param src source block
+		 * \param idx indexes
+		 * \param start first element
+		 * \param stop last element (excluded)
+		 *
+		 */
+		static inline void gather(const gather_block & dst, const gather_block & src, const size_t * idx, size_t start, size_t stop)
+		{
+			word * d = reinterpret_cast<word *>(dst.ptr);
+			const word * s = reinterpret_cast<const word *>(src.ptr);
+
+			for (size_t i = start ; i < stop ; i += gather_prefetch)
+			{
+				size_t e = (i + gather_prefetch < stop)?i + gather_prefetch:stop;
+				size_t ep = (e + gather_prefetch < stop)?e + gather_prefetch:stop;
+
+				for (size_t j = e ; j < ep ; j++)
+				{__builtin_prefetch(s + idx[j],0,0);}
+
+				#pragma omp simd
+				for (size_t j = i ; j < e ; j++)
+				{d[j] = s[idx[j]];}
+			}
+		}
+
+		/*! \brief dst[idx[i]] = src[i] for i in [start,stop)
+		 *
+		 * \param dst destination block
+		 * \param src source block
+		 * \param idx indexes
+		 * \param start first element
+		 * \param stop last element (excluded)
+		 *
+		 */
+		static inline void scatter(const gather_block & dst, const gather_block & src, const size_t * idx, size_t start, size_t stop)
+		{
+			word * d = reinterpret_cast<word *>(dst.ptr);
+			const word * s = reinterpret_cast<const word *>(src.ptr);
+
+			for (size_t i = start ; i < stop ; i += gather_prefetch)
+			{
+				size_t e = (i + gather_prefetch < stop)?i + gather_prefetch:stop;
+				size_t ep = (e + gather_prefetch < stop)?e + gather_prefetch:stop;
+
+				for (size_t j = e ; j < ep ; j++)
+				{__builtin_prefetch(d + idx[j],1,0);}
+
+				#pragma omp simd
+				for (size_t j = i ; j < e ; j++)
+				{d[idx[j]] = s[j];}
+			}
+		}
+	};
+
+	//! Generic element size and stride
+	template<>
+	struct gather_kernel<0>
+	{
+		static inline void gather(const gather_block & dst, const gather_block & src, const size_t * idx, size_t start, size_t stop)
+		{
+			for (size_t i = start ; i < stop ; i++)
+			{
+				if (i + gather_prefetch < stop)
+				{__builtin_prefetch(src.ptr + idx[i + gather_prefetch]*src.stride,0,0);}
+
+				std::memcpy(dst.ptr + i*dst.stride,src.ptr + idx[i]*src.stride,src.es);
+			}
+		}
+
+		static inline void scatter(const gather_block & dst, const gather_block & src, const size_t * idx, size_t start, size_t stop)
+		{
+			for (size_t i = start ; i < stop ; i++)
+			{
+				if (i + gather_prefetch < stop)
+				{__builtin_prefetch(dst.ptr + idx[i + gather_prefetch]*dst.stride,1,0);}
+
+				std::memcpy(dst.ptr + idx[i]*dst.stride,src.ptr + i*src.stride,src.es);
+			}
+		}
+	};
+
+	/*! \brief Copy with indirect addressing between two lists of blocks
+	 *
+	 * The block b of dst correspond to the block b of src. The elements are processed in
+	 * tiles of gather_tile elements distributed across the threads
+	 *
+	 * \tparam is_scatter false: dst[i] = src[idx[i]], true: dst[idx[i]] = src[i]
+	 *
+	 * \param dst destination blocks
+	 * \param src source blocks
+	 * \param idx indexes
+	 * \param n number of indexes
+	 *
+	 */
+	template<bool is_scatter>
+	void gather_blocks_run(const std::vector<gather_block> & dst, const std::vector<gather_block> & src, const size_t * idx, size_t n)
+	{
+		if (n == 0)	{return;}
+
+		size_t n_tile = (n + gather_tile - 1) / gather_tile;
+
+		#pragma omp parallel for num_threads(cpu_num_threads_for(n)) schedule(static)
+		for (size_t t = 0 ; t < n_tile ; t++)
+		{
+			size_t start = t*gather_tile;
+			size_t stop = (start + gather_tile < n)?start + gather_tile:n;
+
+			for (size_t b = 0 ; b < src.size() ; b++)
+			{
+				bool dense = (src[b].es == src[b].stride && dst[b].es == dst[b].stride);
+
+				if (dense == true && src[b].es == 4)
+				{
+					if (is_scatter == true)	{gather_kernel<4>::scatter(dst[b],src[b],idx,start,stop);}
+					else					{gather_kernel<4>::gather(dst[b],src[b],idx,start,stop);}
+				}
+				else if (dense == true && src[b].es == 8)
+				{
+					if (is_scatter == true)	{gather_kernel<8>::scatter(dst[b],src[b],idx,start,stop);}
+					else					{gather_kernel<8>::gather(dst[b],src[b],idx,start,stop);}
+				}
+				else
+				{
+					if (is_scatter == true)	{gather_kernel<0>::scatter(dst[b],src[b],idx,start,stop);}
+					else					{gather_kernel<0>::gather(dst[b],src[b],idx,start,stop);}
+				}
+			}
+		}
+	}
+
+	/*! \brief For each selected property add the blocks of a vector with memory_traits_lin
+	 *
+	 * Every property is a field of the objects
+	 *
+	 * \tparam vector_type type of the vector
+	 *
+	 */
+	template<typename vector_type>
+	struct gather_blocks_lin_prp
+	{
+		//! pointer to the objects
+		unsigned char * ptr;
+
+		//! blocks
+		std::vector<gather_block> & blk;
+
+		/*! \brief constructor
+		 *
+		 * \param ptr pointer to the objects
+		 * \param blk blocks (output)
+		 *
+		 */
+		gather_blocks_lin_prp(unsigned char * ptr, std::vector<gather_block> & blk)
+		:ptr(ptr),blk(blk)
+		{}
+
+		//! It add the block of the property T::value
+		template<typename T>
+		inline void operator()(T& t)
+		{
+			typedef typename vector_type::value_type::type type;
+
+			type obj;
+			size_t off = reinterpret_cast<unsigned char *>(&boost::fusion::at_c<T::value>(obj)) - reinterpret_cast<unsigned char *>(&obj);
+
+			blk.push_back(gather_block{ptr + off,sizeof(boost::fusion::at_c<T::value>(obj)),sizeof(type)});
+		}
+	};
+
+	/*! \brief Get the blocks of the selected properties of a vector
+	 *
+	 * \tparam is_inte true if the layout is memory_traits_inte
+	 * \tparam prp selected properties (all if none)
+	 *
+	 */
+	template<bool is_inte, unsigned int ... prp>
+	struct gather_blocks
+	{
+		template<typename vector_type>
+		static void get(vector_type & v, std::vector<gather_block> & blk)
+		{
+			gather_blocks_lin_prp<vector_type> gb(static_cast<unsigned char *>(v.getPointer()),blk);
+			boost::mpl::for_each_ref< boost::mpl::vector_c<unsigned int,prp...> >(gb);
+		}
+	};
+
+	//! all the properties of a vector with memory_traits_lin, the whole objects
+	template<>
+	struct gather_blocks<false>
+	{
+		template<typename vector_type>
+		static void get(vector_type & v, std::vector<gather_block> & blk)
+		{
+			size_t sz = sizeof(typename vector_type::value_type::type);
+			blk.push_back(gather_block{static_cast<unsigned char *>(v.getPointer()),sz,sz});
+		}
+	};
+
+	//! selected properties of a vector with memory_traits_inte
+	template<unsigned int ... prp>
+	struct gather_blocks<true,prp...>
+	{
+		template<typename vector_type>
+		static void get(vector_type & v, std::vector<gather_block> & blk)
+		{
+			std::vector<compact_block> cblk;
+
+			compact_blocks_prp<vector_type> cb(v,cblk);
+			boost::mpl::for_each_ref< boost::mpl::vector_c<unsigned int,prp...> >(cb);
+
+			for (size_t b = 0 ; b < cblk.size() ; b++)
+			{blk.push_back(gather_block{cblk[b].ptr,cblk[b].es,cblk[b].es});}
+		}
+	};
+
+	//! all the properties of a vector with memory_traits_inte
+	template<>
+	struct gather_blocks<true>
+	{
+		template<typename vector_type>
+		static void get(vector_type & v, std::vector<gather_block> & blk)
+		{
+			std::vector<compact_block> cblk;
+			compact_blocks<true>::get(v,cblk);
+
+			for (size_t b = 0 ; b < cblk.size() ; b++)
+			{blk.push_back(gather_block{cblk[b].ptr,cblk[b].es,cblk[b].es});}
+		}
+	};
+
+	/*! \brief Copy one element from a vector into another, all the properties
+	 *
+	 * \tparam all_prp true when no property has been selected
+	 *
+	 */
+	template<bool all_prp, unsigned int ... prp>
+	struct gather_set_impl
+	{
+		template<typename vector_type>
+		static inline void set(vector_type & v_dst, size_t dst, vector_type & v_src, size_t src)
+		{
+			v_dst.set(dst,v_src,src);
+		}
+	};
+
+	//! Copy one element from a vector into another, only the selected properties
+	template<unsigned int ... prp>
+	struct gather_set_impl<false,prp...>
+	{
+		template<typename vector_type>
+		static inline void set(vector_type & v_dst, size_t dst, vector_type & v_src, size_t src)
+		{
+			v_dst.template set<prp ...>(dst,v_src,src);
+		}
+	};
+
+	/*! \brief Copy the selected properties between two vectors with indirect addressing
+	 *
+	 * The vectors must satisfy vector_compact_bulk and have the right size
+	 *
+	 * \tparam is_scatter false: dst[i] = src[idx[i]], true: dst[idx[i]] = src[i]
+	 * \tparam prp selected properties (all if none)
+	 *
+	 * \param dst destination vector
+	 * \param src source vector
+	 * \param idx indexes
+	 * \param n number of indexes
+	 *
+	 */
+	template<bool is_scatter, unsigned int ... prp, typename vector_type>
+	void vector_gather(vector_type & dst, vector_type & src, const size_t * idx, size_t n)
+	{
+		if (n == 0)	{return;}
+
+		const bool is_inte = is_layout_inte<typename vector_type::layout_base_>::value;
+
+		std::vector<gather_block> blk_dst;
+		std::vector<gather_block> blk_src;
+
+		gather_blocks<is_inte,prp...>::get(dst,blk_dst);
+		gather_blocks<is_inte,prp...>::get(src,blk_src);
+
+		gather_blocks_run<is_scatter>(blk_dst,blk_src,idx,n);
+	}
+}
+
+#endif /* OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_GATHER_HPP_ */
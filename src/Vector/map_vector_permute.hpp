@@ -0,0 +1,120 @@
+/*
+ * map_vector_permute.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_PERMUTE_HPP_
+#define OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_PERMUTE_HPP_
+
+#include "Vector/map_vector_compact.hpp"
+
+namespace openfpm
+{
+	//! number of elements gathered by a thread in one step
+	constexpr size_t permute_tile = 4096;
+
+	/*! \brief Gather the elements [start,stop) of a block following a permutation
+	 *
+	 * \tparam es size of one element known at compile time (0 = use the size of the block)
+	 *
+	 */
+	template<unsigned int es>
+	struct permute_gather
+	{
+		static inline void gather(unsigned char * dst, const compact_block & b, const size_t * perm, size_t start, size_t stop)
+		{
+			for (size_t i = start ; i < stop ; i++)
+			{std::memcpy(dst + i*es,b.ptr + perm[i]*es,es);}
+		}
+	};
+
+	//! element size known only at run-time
+	template<>
+	struct permute_gather<0>
+	{
+		static inline void gather(unsigned char * dst, const compact_block & b, const size_t * perm, size_t start, size_t stop)
+		{
+			for (size_t i = start ; i < stop ; i++)
+			{std::memcpy(dst + i*b.es,b.ptr + perm[i]*b.es,b.es);}
+		}
+	};
+
+	/*! \brief Apply a permutation to a set of blocks, the element i become the element perm[i]
+	 *
+	 * Every block is gathered into a temporal buffer and copied back. The destination is
+	 * processed in tiles of permute_tile elements, distributed across the threads
+	 *
+	 * \param blk memory blocks
+	 * \param n number of elements
+	 * \param perm permutation
+	 *
+	 */
+	inline void permute_blocks_run(const std::vector<compact_block> & blk, size_t n, const size_t * perm)
+	{
+		if (n == 0)	{return;}
+
+		size_t max_es = 0;
+		for (size_t b = 0 ; b < blk.size() ; b++)
+		{max_es = (blk[b].es > max_es)?blk[b].es:max_es;}
+
+		std::vector<unsigned char> tmp(n*max_es);
+
+		size_t n_tile = (n + permute_tile - 1) / permute_tile;
+		int nt = cpu_num_threads_for(n);
+
+		for (size_t b = 0 ; b < blk.size() ; b++)
+		{
+			const compact_block & bk = blk[b];
+
+			#pragma omp parallel num_threads(nt)
+			{
+				#pragma omp for schedule(static)
+				for (size_t t = 0 ; t < n_tile ; t++)
+				{
+					size_t start = t*permute_tile;
+					size_t stop = (start + permute_tile < n)?start + permute_tile:n;
+
+					if (bk.es == 4)
+					{permute_gather<4>::gather(tmp.data(),bk,perm,start,stop);}
+					else if (bk.es == 8)
+					{permute_gather<8>::gather(tmp.data(),bk,perm,start,stop);}
+					else
+					{permute_gather<0>::gather(tmp.data(),bk,perm,start,stop);}
+				}
+
+				#pragma omp for schedule(static)
+				for (size_t t = 0 ; t < n_tile ; t++)
+				{
+					size_t start = t*permute_tile;
+					size_t stop = (start + permute_tile < n)?start + permute_tile:n;
+
+					std::memcpy(bk.ptr + start*bk.es,tmp.data() + start*bk.es,(stop - start)*bk.es);
+				}
+			}
+		}
+	}
+
+	/*! \brief Apply a permutation to the elements [0,n) of a vector, the element i become the element perm[i]
+	 *
+	 * The vector must satisfy vector_compact_bulk
+	 *
+	 * \param v vector
+	 * \param n number of elements
+	 * \param perm permutation
+	 *
+	 */
+	template<typename vector_type>
+	void vector_permute(vector_type & v, size_t n, const size_t * perm)
+	{
+		if (n == 0)	{return;}
+
+		std::vector<compact_block> blk;
+		compact_blocks<is_layout_inte<typename vector_type::layout_base_>::value>::get(v,blk);
+
+		permute_blocks_run(blk,n,perm);
+	}
+}
+
+#endif /* OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_PERMUTE_HPP_ */
@@ -6,6 +6,7 @@
 #include "memory/ExtPreAlloc.hpp"
 #include "memory/PtrMemory.hpp"
 #include <cstring>
+#include <random>
 #include "Space/Shape/Point.hpp"
 #include "util/object_util.hpp"
 #include "vector_test_util.hpp"
@@ -156,6 +157,330 @@ template <typename vector> void test_vector_remove()
 	}
 }
 
+/*! \brief Check that the element i of the vector is the original element o
+ *
+ * \param v vector
+ * \param i element
+ * \param o original element
+ *
+ * \return true if all the properties match
+ *
+ */
+template <typename vector> bool check_vector_remove_bulk(vector & v, size_t i, size_t o)
+{
+	typedef Point_test<float> p;
+
+	bool ret = true;
+
+	ret &= v.template get<p::x>(i) == o;
+	ret &= v.template get<p::s>(i) == 2*o;
+
+	for (size_t j = 0 ; j < 3 ; j++)
+	{
+		ret &= v.template get<p::v>(i)[j] == o + j;
+
+		for (size_t k = 0 ; k < 3 ; k++)
+		{ret &= v.template get<p::t>(i)[j][k] == o + 3*j + k;}
+	}
+
+	return ret;
+}
+
+template <typename vector> void test_vector_remove_bulk()
+{
+	typedef Point_test<float> p;
+
+	// big enough to be compacted by several threads
+
+	size_t n = 100000;
+
+	vector v1;
+	v1.resize(n);
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		v1.template get<p::x>(i) = i;
+		v1.template get<p::s>(i) = 2*i;
+
+		for (size_t j = 0 ; j < 3 ; j++)
+		{
+			v1.template get<p::v>(i)[j] = i + j;
+
+			for (size_t k = 0 ; k < 3 ; k++)
+			{v1.template get<p::t>(i)[j][k] = i + 3*j + k;}
+		}
+	}
+
+	// sparse removals and a big hole
+
+	openfpm::vector<size_t> rem;
+	openfpm::vector<size_t> orig;
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		if (i % 7 == 3 || (i >= 20000 && i < 60000))
+		{rem.add(i);}
+		else
+		{orig.add(i);}
+	}
+
+	v1.remove(rem);
+
+	BOOST_REQUIRE_EQUAL(v1.size(),orig.size());
+
+	bool ret = true;
+	for (size_t i = 0 ; i < v1.size() ; i++)
+	{ret &= check_vector_remove_bulk(v1,i,orig.get(i));}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+
+	// remove with predicate
+
+	openfpm::vector<size_t> orig2;
+	for (size_t i = 0 ; i < orig.size() ; i++)
+	{
+		if (orig.get(i) % 5 != 0)
+		{orig2.add(orig.get(i));}
+	}
+
+	v1.remove_if([&](size_t i){return ((size_t)v1.template get<p::x>(i)) % 5 == 0;});
+
+	BOOST_REQUIRE_EQUAL(v1.size(),orig2.size());
+
+	for (size_t i = 0 ; i < v1.size() ; i++)
+	{ret &= check_vector_remove_bulk(v1,i,orig2.get(i));}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+
+	// remove everything
+
+	v1.remove_if([](size_t i){return true;});
+
+	BOOST_REQUIRE_EQUAL(v1.size(),0ul);
+}
+
+template <typename vector> void test_vector_sort_by()
+{
+	typedef Point_test<float> p;
+
+	size_t n = 100000;
+
+	std::default_random_engine eg;
+	std::uniform_int_distribution<int> ud(-500,500);
+
+	vector v1;
+	v1.resize(n);
+
+	// the key has many duplicates, the other properties identify the element
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		v1.template get<p::x>(i) = ud(eg) * 0.25f;
+		v1.template get<p::y>(i) = i;
+		v1.template get<p::s>(i) = 2*i;
+
+		for (size_t j = 0 ; j < 3 ; j++)
+		{
+			v1.template get<p::v>(i)[j] = i + j;
+
+			for (size_t k = 0 ; k < 3 ; k++)
+			{v1.template get<p::t>(i)[j][k] = i + 3*j + k;}
+		}
+	}
+
+	vector v2 = v1;
+
+	openfpm::vector<size_t> perm;
+	v1.template sort_by<p::x>(perm);
+
+	BOOST_REQUIRE_EQUAL(v1.size(),n);
+	BOOST_REQUIRE_EQUAL(perm.size(),n);
+
+	bool ret = true;
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		size_t o = perm.get(i);
+
+		if (i != 0)
+		{
+			// sorted and stable
+			ret &= v1.template get<p::x>(i-1) <= v1.template get<p::x>(i);
+			ret &= v1.template get<p::x>(i-1) != v1.template get<p::x>(i) || perm.get(i-1) < o;
+		}
+
+		ret &= v1.template get<p::x>(i) == v2.template get<p::x>(o);
+		ret &= v1.template get<p::y>(i) == o;
+		ret &= v1.template get<p::s>(i) == 2*o;
+
+		for (size_t j = 0 ; j < 3 ; j++)
+		{
+			ret &= v1.template get<p::v>(i)[j] == o + j;
+
+			for (size_t k = 0 ; k < 3 ; k++)
+			{ret &= v1.template get<p::t>(i)[j][k] == o + 3*j + k;}
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+
+	// descending by an integer-valued property
+
+	v1.template sort_by<p::s>(true);
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		ret &= v1.template get<p::s>(i) == 2*(n-1-i);
+		ret &= v1.template get<p::y>(i) == n-1-i;
+		ret &= v1.template get<p::v>(i)[2] == n-1-i + 2;
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+}
+
+/*! \brief Fill the element i of a Point_test vector with values identifying o
+ *
+ * \param v vector
+ * \param i element
+ * \param o identifier
+ *
+ */
+template <typename vector> void fill_vector_gather(vector & v, size_t i, size_t o)
+{
+	typedef Point_test<float> p;
+
+	v.template get<p::x>(i) = o;
+	v.template get<p::y>(i) = o + 1;
+	v.template get<p::z>(i) = o + 2;
+	v.template get<p::s>(i) = o + 3;
+
+	for (size_t j = 0 ; j < 3 ; j++)
+	{
+		v.template get<p::v>(i)[j] = o + j;
+
+		for (size_t k = 0 ; k < 3 ; k++)
+		{v.template get<p::t>(i)[j][k] = o + 3*j + k;}
+	}
+}
+
+template <typename vector> void test_vector_gather_scatter()
+{
+	typedef Point_test<float> p;
+
+	size_t n = 50000;
+
+	std::default_random_engine eg;
+
+	vector v1;
+	v1.resize(n);
+
+	for (size_t i = 0 ; i < n ; i++)
+	{fill_vector_gather(v1,i,i);}
+
+	// gather all the properties, the indexes can repeat
+
+	openfpm::vector<size_t> idx;
+	for (size_t i = 0 ; i < 2*n ; i++)
+	{idx.add(eg() % n);}
+
+	vector v2;
+	v2.gather(v1,idx);
+
+	BOOST_REQUIRE_EQUAL(v2.size(),idx.size());
+
+	vector chk;
+	chk.resize(1);
+
+	bool ret = true;
+	for (size_t i = 0 ; i < v2.size() ; i++)
+	{
+		fill_vector_gather(chk,0,idx.get(i));
+		ret &= v2.template get<p::x>(i) == chk.template get<p::x>(0);
+		ret &= v2.template get<p::s>(i) == chk.template get<p::s>(0);
+		ret &= v2.template get<p::v>(i)[2] == chk.template get<p::v>(0)[2];
+		ret &= v2.template get<p::t>(i)[2][1] == chk.template get<p::t>(0)[2][1];
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+
+	// gather a subset of properties, the others are untouched
+
+	vector v3;
+	v3.resize(idx.size());
+	for (size_t i = 0 ; i < v3.size() ; i++)
+	{fill_vector_gather(v3,i,0);}
+
+	v3.template gather<p::y,p::v>(v1,idx);
+
+	for (size_t i = 0 ; i < v3.size() ; i++)
+	{
+		ret &= v3.template get<p::x>(i) == 0;
+		ret &= v3.template get<p::y>(i) == idx.get(i) + 1;
+		ret &= v3.template get<p::s>(i) == 3;
+		ret &= v3.template get<p::v>(i)[0] == idx.get(i);
+		ret &= v3.template get<p::v>(i)[2] == idx.get(i) + 2;
+		ret &= v3.template get<p::t>(i)[1][1] == 4;
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+
+	// scatter with a permutation
+
+	openfpm::vector<size_t> perm;
+	for (size_t i = 0 ; i < n ; i++)
+	{perm.add((i * 7919) % n);}
+
+	vector v4;
+	v4.resize(n);
+	v1.scatter(v4,perm);
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		size_t o = perm.get(i);
+
+		ret &= v4.template get<p::x>(o) == i;
+		ret &= v4.template get<p::z>(o) == i + 2;
+		ret &= v4.template get<p::v>(o)[1] == i + 1;
+		ret &= v4.template get<p::t>(o)[2][2] == i + 8;
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+
+	// gather and scatter in place
+
+	vector v5(v1);
+	v5.gather(v5,idx);
+
+	vector v6(v1);
+	v6.scatter(v6,perm);
+
+	BOOST_REQUIRE_EQUAL(v5.size(),v2.size());
+
+	for (size_t i = 0 ; i < v5.size() ; i++)
+	{
+		ret &= v5.template get<p::x>(i) == v2.template get<p::x>(i);
+		ret &= v5.template get<p::t>(i)[2][1] == v2.template get<p::t>(i)[2][1];
+	}
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		ret &= v6.template get<p::x>(i) == v4.template get<p::x>(i);
+		ret &= v6.template get<p::v>(i)[1] == v4.template get<p::v>(i)[1];
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+
+	// scatter only one property
+
+	v4.template scatter<p::s>(v1,perm);
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		ret &= v1.template get<p::x>(perm.get(i)) == perm.get(i);
+		ret &= v1.template get<p::s>(perm.get(i)) == v4.template get<p::s>(i);
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+}
+
 template <typename vector> void test_vector_insert()
 {
 	typedef Point_test<float> p;
@@ -446,6 +771,71 @@ BOOST_AUTO_TEST_CASE(vector_remove )
 	test_vector_remove< openfpm::vector<Point_test<float>,HeapMemory, memory_traits_inte> >();
 }
 
+BOOST_AUTO_TEST_CASE(vector_remove_bulk )
+{
+	test_vector_remove_bulk<openfpm::vector<Point_test<float>>>();
+	test_vector_remove_bulk< openfpm::vector<Point_test<float>,HeapMemory, memory_traits_inte> >();
+}
+
+BOOST_AUTO_TEST_CASE(vector_gather_scatter )
+{
+	test_vector_gather_scatter<openfpm::vector<Point_test<float>>>();
+	test_vector_gather_scatter< openfpm::vector<Point_test<float>,HeapMemory, memory_traits_inte> >();
+
+	// objects that cannot be copied as raw memory
+
+	openfpm::vector<aggregate<int,openfpm::vector<int>>> v;
+
+	for (int i = 0 ; i < 100 ; i++)
+	{
+		v.add();
+		v.last().template get<0>() = i;
+		v.last().template get<1>().add(2*i);
+	}
+
+	openfpm::vector<size_t> idx;
+	for (size_t i = 0 ; i < 100 ; i++)
+	{idx.add(99 - i);}
+
+	openfpm::vector<aggregate<int,openfpm::vector<int>>> v2;
+	v2.gather(v,idx);
+
+	bool ret = true;
+	for (int i = 0 ; i < 100 ; i++)
+	{
+		ret &= v2.template get<0>(i) == 99 - i;
+		ret &= v2.template get<1>(i).size() == 1 && v2.template get<1>(i).get(0) == 2*(99 - i);
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+}
+
+BOOST_AUTO_TEST_CASE(vector_sort_by )
+{
+	test_vector_sort_by<openfpm::vector<Point_test<float>>>();
+	test_vector_sort_by< openfpm::vector<Point_test<float>,HeapMemory, memory_traits_inte> >();
+
+	openfpm::vector<aggregate<int,openfpm::vector<int>>> v;
+
+	for (int i = 0 ; i < 100 ; i++)
+	{
+		v.add();
+		v.last().template get<0>() = (i * 37) % 100 - 50;
+		v.last().template get<1>().add(i);
+	}
+
+	v.template sort_by<0>();
+
+	bool ret = true;
+	for (int i = 0 ; i < 100 ; i++)
+	{
+		ret &= v.template get<0>(i) == i - 50;
+		ret &= v.template get<1>(i).size() == 1 && (v.template get<1>(i).get(0) * 37) % 100 - 50 == i - 50;
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+}
+
 BOOST_AUTO_TEST_CASE(vector_insert )
 {
 	test_vector_insert<openfpm::vector<Point_test<float>>>();
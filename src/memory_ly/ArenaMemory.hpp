@@ -0,0 +1,538 @@
+/*
+ * ArenaMemory.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_MEMORY_LY_ARENAMEMORY_HPP_
+#define OPENFPM_DATA_SRC_MEMORY_LY_ARENAMEMORY_HPP_
+
+#include "memory/HeapMemory.hpp"
+#include <mutex>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+//! log2 of the smallest size class of the arena
+#define ARENA_MIN_CLASS_LOG 6
+
+//! number of powers of two covered by the size classes
+#define ARENA_N_POW 40
+
+//! number of size classes for every power of two
+#define ARENA_SUB_CLASS 4
+
+//! alignment of the buffers of the arena
+#define ARENA_ALIGNMENT 64
+
+/*! \brief Counters of a memory_arena
+ *
+ * The event counters (n_get, n_reuse, n_malloc, n_put, n_trim) and the peak count from the
+ * last reset, the bytes in use and cached are the actual state of the arena
+ *
+ */
+struct memory_arena_stat
+{
+	//! number of buffers requested
+	size_t n_get = 0;
+
+	//! number of buffers served from the cache (no malloc, no page faults)
+	size_t n_reuse = 0;
+
+	//! number of buffers allocated from the system
+	size_t n_malloc = 0;
+
+	//! number of buffers given back to the arena
+	size_t n_put = 0;
+
+	//! number of cached buffers given back to the system by reset
+	size_t n_trim = 0;
+
+	//! bytes of the buffers in use
+	size_t bytes_in_use = 0;
+
+	//! bytes of the cached buffers
+	size_t bytes_cached = 0;
+
+	//! maximum of bytes_in_use + bytes_cached
+	size_t bytes_peak = 0;
+};
+
+/*! \brief Size-class arena that recycle buffers without going through malloc/free
+ *
+ * The requested size is rounded up to a size class (ARENA_SUB_CLASS classes for every power of two,
+ * so the waste is smaller than 1/ARENA_SUB_CLASS). A buffer given back is kept in the free list of
+ * its class and reused by the next request of the same class, already mapped in memory.
+ *
+ * reset() is intended to be called once per time-step, it restart the event counters and give
+ * back to the system the cached buffers that were never needed during the step (for every class
+ * the minimum size of the free list along the step), so the cache follow the working set.
+ * release() give back all the cached buffers
+ *
+ * The arena is thread safe
+ *
+ */
+class memory_arena
+{
+	//! number of size classes
+	static const size_t n_class = ARENA_N_POW * ARENA_SUB_CLASS;
+
+	//! mutex
+	std::mutex mtx;
+
+	//! cached buffers for every class
+	std::vector<void *> free_list[n_class];
+
+	//! minimum size of the free list of every class since the last reset
+	size_t low[n_class] = {};
+
+	//! counters
+	memory_arena_stat st;
+
+	/*! \brief Give back to the system n buffers of the class c
+	 *
+	 * \param c class
+	 * \param n number of buffers
+	 *
+	 */
+	void free_class(size_t c, size_t n)
+	{
+		for (size_t i = 0 ; i < n ; i++)
+		{
+			::free(free_list[c].back());
+			free_list[c].pop_back();
+			st.bytes_cached -= class_size(c);
+		}
+	}
+
+public:
+
+	/*! \brief Return the size class of a buffer of sz bytes
+	 *
+	 * \param sz size in bytes
+	 *
+	 * \return the class
+	 *
+	 */
+	static size_t get_class(size_t sz)
+	{
+		size_t k = ARENA_MIN_CLASS_LOG;
+		while (k < ARENA_MIN_CLASS_LOG + ARENA_N_POW - 1 && ((size_t)1 << (k+1)) < sz)	{k++;}
+
+		size_t base = (size_t)1 << k;
+		size_t step = base / ARENA_SUB_CLASS;
+
+		if (sz <= base)	{return (k - ARENA_MIN_CLASS_LOG)*ARENA_SUB_CLASS;}
+
+		size_t sub = (sz - base + step - 1) / step;
+
+		if (sub >= ARENA_SUB_CLASS)	{return (k + 1 - ARENA_MIN_CLASS_LOG)*ARENA_SUB_CLASS;}
+
+		return (k - ARENA_MIN_CLASS_LOG)*ARENA_SUB_CLASS + sub;
+	}
+
+	/*! \brief Return the size in bytes of the buffers of a class
+	 *
+	 * \param c class
+	 *
+	 * \return the size in bytes
+	 *
+	 */
+	static size_t class_size(size_t c)
+	{
+		size_t k = c / ARENA_SUB_CLASS + ARENA_MIN_CLASS_LOG;
+		size_t base = (size_t)1 << k;
+
+		return base + (c % ARENA_SUB_CLASS) * (base / ARENA_SUB_CLASS);
+	}
+
+	/*! \brief Get a buffer of at least sz bytes
+	 *
+	 * \param sz size in bytes
+	 * \param c class of the buffer (output)
+	 *
+	 * \return the buffer, NULL if the allocation failed
+	 *
+	 */
+	void * get(size_t sz, size_t & c)
+	{
+		c = get_class(sz);
+
+		if (c >= n_class)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error the arena cannot allocate " << sz << " bytes" << std::endl;
+			return NULL;
+		}
+
+		std::lock_guard<std::mutex> lk(mtx);
+
+		st.n_get++;
+
+		void * ptr = NULL;
+
+		if (free_list[c].size() != 0)
+		{
+			ptr = free_list[c].back();
+			free_list[c].pop_back();
+			low[c] = (free_list[c].size() < low[c])?free_list[c].size():low[c];
+
+			st.n_reuse++;
+			st.bytes_cached -= class_size(c);
+		}
+		else
+		{
+			if (posix_memalign(&ptr,ARENA_ALIGNMENT,class_size(c)) != 0)
+			{
+				std::cerr << __FILE__ << ":" << __LINE__ << " error the arena failed to allocate " << class_size(c) << " bytes" << std::endl;
+				return NULL;
+			}
+
+			st.n_malloc++;
+		}
+
+		st.bytes_in_use += class_size(c);
+		st.bytes_peak = (st.bytes_in_use + st.bytes_cached > st.bytes_peak)?st.bytes_in_use + st.bytes_cached:st.bytes_peak;
+
+		return ptr;
+	}
+
+	/*! \brief Give back a buffer
+	 *
+	 * \param ptr buffer
+	 * \param c class of the buffer
+	 *
+	 */
+	void put(void * ptr, size_t c)
+	{
+		if (ptr == NULL)	{return;}
+
+		std::lock_guard<std::mutex> lk(mtx);
+
+		free_list[c].push_back(ptr);
+
+		st.n_put++;
+		st.bytes_in_use -= class_size(c);
+		st.bytes_cached += class_size(c);
+	}
+
+	/*! \brief Start a new time-step
+	 *
+	 * The cached buffers not used since the last reset are given back to the system and the
+	 * event counters restart
+	 *
+	 */
+	void reset()
+	{
+		std::lock_guard<std::mutex> lk(mtx);
+
+		size_t n_trim = 0;
+
+		for (size_t c = 0 ; c < n_class ; c++)
+		{
+			size_t n = (low[c] < free_list[c].size())?low[c]:free_list[c].size();
+			free_class(c,n);
+			n_trim += n;
+
+			low[c] = free_list[c].size();
+		}
+
+		st.n_get = 0;
+		st.n_reuse = 0;
+		st.n_malloc = 0;
+		st.n_put = 0;
+		st.n_trim = n_trim;
+		st.bytes_peak = st.bytes_in_use + st.bytes_cached;
+	}
+
+	/*! \brief Give back to the system all the cached buffers
+	 *
+	 */
+	void release()
+	{
+		std::lock_guard<std::mutex> lk(mtx);
+
+		for (size_t c = 0 ; c < n_class ; c++)
+		{
+			free_class(c,free_list[c].size());
+			low[c] = 0;
+		}
+	}
+
+	/*! \brief Return the counters
+	 *
+	 * \return the counters
+	 *
+	 */
+	memory_arena_stat getStat()
+	{
+		std::lock_guard<std::mutex> lk(mtx);
+
+		return st;
+	}
+
+	//! destructor
+	~memory_arena()
+	{
+		release();
+	}
+};
+
+/*! \brief Memory that take the buffers from a memory_arena
+ *
+ * It can be used as the Memory template parameter of openfpm::vector or grid like
+ * HeapMemory. It is intended for temporal objects created and destroyed at every call
+ * (or time-step), their buffers are recycled from the arena without malloc/free and without
+ * page faults. On host the device functions behave like HeapMemory
+ *
+ * All the ArenaMemory use the arena returned by ArenaMemory::getArena()
+ *
+ * ### Example
+ *
+ * \code
+ * openfpm::vector<aggregate<float,float[3]>,ArenaMemory> tmp;
+ * tmp.resize(n);
+ *
+ * // ... at the end of the time-step
+ * ArenaMemory::getArena().reset();
+ * \endcode
+ *
+ */
+class ArenaMemory : public HeapMemory
+{
+	//! buffer
+	void * buf;
+
+	//! size requested
+	size_t sz;
+
+	//! class of the buffer in the arena
+	size_t cls;
+
+public:
+
+	/*! \brief Return the arena of the ArenaMemory objects
+	 *
+	 * \return the arena
+	 *
+	 */
+	static memory_arena & getArena()
+	{
+		static memory_arena arena;
+
+		return arena;
+	}
+
+	/*! \brief Allocate sz bytes
+	 *
+	 * \param sz size in bytes
+	 *
+	 * \return true if success
+	 *
+	 */
+	virtual bool allocate(size_t sz)
+	{
+		destroy();
+
+		buf = getArena().get(sz,cls);
+		this->sz = (buf == NULL)?0:sz;
+
+		return buf != NULL;
+	}
+
+	/*! \brief Give back the buffer to the arena
+	 *
+	 */
+	virtual void destroy()
+	{
+		if (buf != NULL)
+		{getArena().put(buf,cls);}
+
+		buf = NULL;
+		sz = 0;
+	}
+
+	/*! \brief Copy the content of another memory, resize if needed
+	 *
+	 * \param m memory to copy
+	 *
+	 * \return true if success
+	 *
+	 */
+	virtual bool copy(const memory & m)
+	{
+		if (m.size() > sz && resize(m.size()) == false)
+		{return false;}
+
+		if (m.size() != 0)
+		{std::memcpy(buf,m.getPointer(),m.size());}
+
+		return true;
+	}
+
+	/*! \brief Return the size of the memory
+	 *
+	 * \return the size in bytes
+	 *
+	 */
+	virtual size_t size() const
+	{
+		return sz;
+	}
+
+	/*! \brief Resize the memory, the content is preserved
+	 *
+	 * If the class of the buffer can contain sz bytes no new buffer is taken
+	 *
+	 * \param sz new size in bytes
+	 *
+	 * \return true if success
+	 *
+	 */
+	virtual bool resize(size_t sz)
+	{
+		if (buf != NULL && sz <= memory_arena::class_size(cls))
+		{
+			this->sz = (sz > this->sz)?sz:this->sz;
+			return true;
+		}
+
+		size_t c;
+		void * nbuf = getArena().get(sz,c);
+
+		if (nbuf == NULL)	{return false;}
+
+		if (buf != NULL)
+		{
+			std::memcpy(nbuf,buf,this->sz);
+			getArena().put(buf,cls);
+		}
+
+		buf = nbuf;
+		cls = c;
+		this->sz = sz;
+
+		return true;
+	}
+
+	/*! \brief Return the pointer to the memory
+	 *
+	 * \return the pointer
+	 *
+	 */
+	virtual void * getPointer()
+	{
+		return buf;
+	}
+
+	/*! \brief Return the pointer to the memory
+	 *
+	 * \return the pointer
+	 *
+	 */
+	virtual const void * getPointer() const
+	{
+		return buf;
+	}
+
+	/*! \brief Return the pointer to the memory (on host it is the same)
+	 *
+	 * \return the pointer
+	 *
+	 */
+	virtual void * getDevicePointer()
+	{
+		return buf;
+	}
+
+	/*! \brief Fill the memory with a byte
+	 *
+	 * \param c byte
+	 *
+	 */
+	virtual void fill(unsigned char c)
+	{
+		if (buf != NULL)
+		{std::memset(buf,c,sz);}
+	}
+
+	/*! \brief Swap the memory with another ArenaMemory
+	 *
+	 * \param mem memory to swap
+	 *
+	 */
+	void swap(ArenaMemory & mem)
+	{
+		std::swap(buf,mem.buf);
+		std::swap(sz,mem.sz);
+		std::swap(cls,mem.cls);
+	}
+
+	/*! \brief Copy the memory
+	 *
+	 * \param mem memory to copy
+	 *
+	 * \return itself
+	 *
+	 */
+	ArenaMemory & operator=(const ArenaMemory & mem)
+	{
+		if (this != &mem)
+		{
+			destroy();
+			copy(mem);
+		}
+
+		return *this;
+	}
+
+	/*! \brief Move the memory
+	 *
+	 * \param mem memory to move
+	 *
+	 * \return itself
+	 *
+	 */
+	ArenaMemory & operator=(ArenaMemory && mem)
+	{
+		swap(mem);
+
+		return *this;
+	}
+
+	//! Constructor
+	ArenaMemory()
+	:HeapMemory(),buf(NULL),sz(0),cls(0)
+	{}
+
+	/*! \brief Copy constructor
+	 *
+	 * \param mem memory to copy
+	 *
+	 */
+	ArenaMemory(const ArenaMemory & mem)
+	:HeapMemory(),buf(NULL),sz(0),cls(0)
+	{
+		copy(mem);
+	}
+
+	/*! \brief Move constructor
+	 *
+	 * \param mem memory to move
+	 *
+	 */
+	ArenaMemory(ArenaMemory && mem)
+	:HeapMemory(),buf(NULL),sz(0),cls(0)
+	{
+		swap(mem);
+	}
+
+	//! Destructor, the buffer go back to the arena
+	virtual ~ArenaMemory() noexcept
+	{
+		destroy();
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_MEMORY_LY_ARENAMEMORY_HPP_ */
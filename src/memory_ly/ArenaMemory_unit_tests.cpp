@@ -0,0 +1,85 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "memory_ly/ArenaMemory.hpp"
+#include "Vector/map_vector.hpp"
+
+BOOST_AUTO_TEST_SUITE( arena_memory_test )
+
+BOOST_AUTO_TEST_CASE( arena_memory_size_class )
+{
+	for (size_t sz = 1 ; sz < 1024*1024 ; sz = sz*3/2 + 1)
+	{
+		size_t c = memory_arena::get_class(sz);
+
+		BOOST_REQUIRE(memory_arena::class_size(c) >= sz);
+		BOOST_REQUIRE(c == 0 || memory_arena::class_size(c-1) < sz);
+	}
+}
+
+template<typename vector_type>
+void test_arena_vector()
+{
+	memory_arena & arena = ArenaMemory::getArena();
+	arena.release();
+	arena.reset();
+
+	bool match = true;
+
+	for (size_t s = 0 ; s < 8 ; s++)
+	{
+		vector_type v;
+
+		for (size_t i = 0 ; i < 1000 ; i++)
+		{
+			v.add();
+			v.template get<0>(v.size()-1) = i + s;
+			v.template get<1>(v.size()-1)[0] = i;
+			v.template get<1>(v.size()-1)[1] = 2*i;
+		}
+
+		vector_type v2 = v;
+
+		for (size_t i = 0 ; i < v2.size() ; i++)
+		{
+			match &= v2.template get<0>(i) == i + s;
+			match &= v2.template get<1>(i)[0] == i;
+			match &= v2.template get<1>(i)[1] == 2*i;
+		}
+
+		if (s == 0)
+		{
+			// the first step fill the arena, the others must reuse it
+
+			memory_arena_stat st = arena.getStat();
+			BOOST_REQUIRE(st.n_malloc != 0);
+			arena.reset();
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	memory_arena_stat st = arena.getStat();
+
+	BOOST_REQUIRE_EQUAL(st.n_malloc,0ul);
+	BOOST_REQUIRE(st.n_reuse != 0);
+	BOOST_REQUIRE_EQUAL(st.bytes_in_use,0ul);
+	BOOST_REQUIRE(st.bytes_cached != 0);
+
+	// two steps without using the arena give back the cached buffers
+
+	arena.reset();
+	arena.reset();
+
+	st = arena.getStat();
+
+	BOOST_REQUIRE_EQUAL(st.bytes_cached,0ul);
+	BOOST_REQUIRE(st.n_trim != 0);
+}
+
+BOOST_AUTO_TEST_CASE( arena_memory_vector )
+{
+	test_arena_vector<openfpm::vector<aggregate<size_t,size_t[2]>,ArenaMemory>>();
+	test_arena_vector<openfpm::vector<aggregate<size_t,size_t[2]>,ArenaMemory,memory_traits_inte>>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
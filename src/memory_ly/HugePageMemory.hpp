@@ -0,0 +1,617 @@
+/*
+ * HugePageMemory.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_MEMORY_LY_HUGEPAGEMEMORY_HPP_
+#define OPENFPM_DATA_SRC_MEMORY_LY_HUGEPAGEMEMORY_HPP_
+
+#include "memory/HeapMemory.hpp"
+#include "util/cpu_parallel_util.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <sys/mman.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+//! pages are placed by the first thread that touch them (touched in parallel at allocation)
+#define NUMA_FIRST_TOUCH 0
+
+//! pages are distributed round-robin across all the online NUMA nodes
+#define NUMA_INTERLEAVE 1
+
+//! pages are allocated on the nodes set with HugePageMemory::setBindNodes
+#define NUMA_BIND 2
+
+//! normal pages
+#define HUGE_PAGE_NONE 0
+
+//! 2 MB pages
+#define HUGE_PAGE_2M 1
+
+//! 1 GB pages
+#define HUGE_PAGE_1G 2
+
+//! buffers smaller than this are taken from the heap with normal pages
+#define HUGE_PAGE_MIN_SIZE 1048576
+
+//! size of a normal page
+#define HUGE_PAGE_BASE_SIZE 4096
+
+//! size of a 2 MB page
+#define HUGE_PAGE_2M_SIZE 2097152ul
+
+//! size of a 1 GB page
+#define HUGE_PAGE_1G_SIZE 1073741824ul
+
+//! mbind modes (numaif.h is part of libnuma, not always installed)
+#define HUGE_PAGE_MPOL_BIND 2
+#define HUGE_PAGE_MPOL_INTERLEAVE 3
+
+/*! \brief Return the mask of the online NUMA nodes (up to 64 nodes)
+ *
+ * It read /sys/devices/system/node/online, if not available only the node 0 is returned
+ *
+ * \return the mask of the nodes
+ *
+ */
+inline unsigned long numa_online_nodes()
+{
+	static unsigned long mask = []()
+	{
+		unsigned long m = 0;
+
+		std::ifstream f("/sys/devices/system/node/online");
+		std::string s;
+
+		if (f.is_open() && std::getline(f,s))
+		{
+			// format: 0-3,5,7-8
+
+			size_t i = 0;
+			while (i < s.size())
+			{
+				size_t e;
+				unsigned long a = std::stoul(s.substr(i),&e);
+				unsigned long b = a;
+				i += e;
+
+				if (i < s.size() && s[i] == '-')
+				{
+					i++;
+					b = std::stoul(s.substr(i),&e);
+					i += e;
+				}
+
+				for (unsigned long n = a ; n <= b && n < 64 ; n++)
+				{m |= 1ul << n;}
+
+				if (i < s.size() && s[i] == ',')	{i++;}
+				else	{break;}
+			}
+		}
+
+		return (m == 0)?1ul:m;
+	}();
+
+	return mask;
+}
+
+/*! \brief Memory for large buffers with huge pages and NUMA placement
+ *
+ * It can be used as the Memory template parameter of openfpm::vector, grid_base and sgrid_cpu
+ * (chunks) like HeapMemory, the policy is selected per container with the template parameters.
+ *
+ * Buffers of at least HUGE_PAGE_MIN_SIZE bytes are mapped with mmap:
+ * * huge pages are first requested with MAP_HUGETLB (pre-reserved pool of the system), if not
+ *   available the mapping fall back to normal pages aligned to 2 MB with madvise(MADV_HUGEPAGE)
+ *   (transparent huge pages, 2 MB only), the size of the fallback mapping is rounded to 2 MB
+ * * with HUGE_PAGE_1G only buffers of at least 1 GB use 1 GB pages, smaller buffers use 2 MB pages
+ * * NUMA_INTERLEAVE and NUMA_BIND set the placement with mbind before any page is touched
+ * * the pages covering the buffer are always touched in parallel by all the threads, every thread take
+ *   one contiguous chunk, the same distribution of an "omp for schedule(static)" on the buffer. With
+ *   NUMA_FIRST_TOUCH every page end on the node of the thread that will process it
+ *
+ * resize, copy and fill work in parallel with the same distribution. Smaller buffers are taken from
+ * the heap, with the device functions they behave like HeapMemory
+ *
+ * ### Example
+ *
+ * \code
+ * openfpm::vector<aggregate<double,double[3]>,HugePageMemory<>,memory_traits_inte> v;
+ * grid_base<3,aggregate<float>,HugePageMemory<NUMA_INTERLEAVE,HUGE_PAGE_1G>> g(sz);
+ * \endcode
+ *
+ * \tparam numa_policy NUMA_FIRST_TOUCH, NUMA_INTERLEAVE or NUMA_BIND
+ * \tparam huge_page HUGE_PAGE_NONE, HUGE_PAGE_2M or HUGE_PAGE_1G
+ *
+ */
+template<unsigned int numa_policy = NUMA_FIRST_TOUCH, unsigned int huge_page = HUGE_PAGE_2M>
+class HugePageMemory : public HeapMemory
+{
+	//! buffer
+	void * buf;
+
+	//! size requested
+	size_t sz;
+
+	//! size of the mapping (0 if the buffer come from the heap)
+	size_t msz;
+
+	//! true if the buffer is mapped with MAP_HUGETLB
+	bool hugetlb;
+
+	/*! \brief Return the nodes used by NUMA_BIND
+	 *
+	 * \return the mask of the nodes
+	 *
+	 */
+	static unsigned long & bind_nodes()
+	{
+		static unsigned long mask = 1;
+
+		return mask;
+	}
+
+	/*! \brief Return the page size for a buffer
+	 *
+	 * 1 GB pages are used only for buffers of at least 1 GB, otherwise most of the page is wasted
+	 *
+	 * \param sz size of the buffer
+	 *
+	 * \return the page size
+	 *
+	 */
+	static size_t page_size(size_t sz)
+	{
+		if (huge_page == HUGE_PAGE_NONE)	{return HUGE_PAGE_BASE_SIZE;}
+
+		return (huge_page == HUGE_PAGE_1G && sz >= HUGE_PAGE_1G_SIZE)?HUGE_PAGE_1G_SIZE:HUGE_PAGE_2M_SIZE;
+	}
+
+	/*! \brief Round a size up to a multiple of a page
+	 *
+	 * \param sz size
+	 * \param ps page size (power of two)
+	 *
+	 * \return the rounded size
+	 *
+	 */
+	static size_t round_page(size_t sz, size_t ps)
+	{
+		return (sz + ps - 1) & ~(ps - 1);
+	}
+
+	/*! \brief Map a buffer of sz bytes
+	 *
+	 * \param sz size of the buffer
+	 * \param msz size of the mapping (output)
+	 * \param htlb true if the mapping use MAP_HUGETLB (output)
+	 *
+	 * \return the mapping, NULL if failed
+	 *
+	 */
+	static void * map(size_t sz, size_t & msz, bool & htlb)
+	{
+		htlb = false;
+
+#ifdef MAP_HUGETLB
+		if (huge_page != HUGE_PAGE_NONE)
+		{
+			size_t ps = page_size(sz);
+			int flag = (ps == HUGE_PAGE_1G_SIZE)?(30 << 26):(21 << 26);
+
+			msz = round_page(sz,ps);
+			void * ptr = mmap(NULL,msz,PROT_READ | PROT_WRITE,MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | flag,-1,0);
+
+			if (ptr != MAP_FAILED)
+			{
+				htlb = true;
+				return ptr;
+			}
+		}
+#endif
+
+		// normal pages aligned (and rounded) to 2 MB, so that transparent huge pages can be used
+
+		size_t al = (huge_page == HUGE_PAGE_NONE)?HUGE_PAGE_BASE_SIZE:HUGE_PAGE_2M_SIZE;
+		msz = round_page(sz,al);
+
+		void * raw = mmap(NULL,msz + al,PROT_READ | PROT_WRITE,MAP_PRIVATE | MAP_ANONYMOUS,-1,0);
+
+		if (raw == MAP_FAILED)	{return NULL;}
+
+		uintptr_t b = reinterpret_cast<uintptr_t>(raw);
+		uintptr_t a = (b + al - 1) & ~(uintptr_t)(al - 1);
+
+		if (a != b)	{munmap(raw,a - b);}
+		if (b + msz + al != a + msz)	{munmap(reinterpret_cast<void *>(a + msz),b + al - a);}
+
+#ifdef MADV_HUGEPAGE
+		if (huge_page != HUGE_PAGE_NONE)
+		{madvise(reinterpret_cast<void *>(a),msz,MADV_HUGEPAGE);}
+#endif
+
+		return reinterpret_cast<void *>(a);
+	}
+
+	/*! \brief Set the NUMA policy of a mapping, before it is touched
+	 *
+	 * It is only an hint, on failure (no NUMA support) the pages are placed by first touch
+	 *
+	 * \param ptr mapping
+	 * \param msz size of the mapping
+	 *
+	 */
+	static void place(void * ptr, size_t msz)
+	{
+#if defined(__linux__) && defined(SYS_mbind)
+		if (numa_policy == NUMA_FIRST_TOUCH)	{return;}
+
+		unsigned long mask = (numa_policy == NUMA_INTERLEAVE)?numa_online_nodes():bind_nodes();
+		int mode = (numa_policy == NUMA_INTERLEAVE)?HUGE_PAGE_MPOL_INTERLEAVE:HUGE_PAGE_MPOL_BIND;
+
+		syscall(SYS_mbind,ptr,msz,mode,&mask,sizeof(unsigned long)*8+1,0);
+#endif
+	}
+
+	/*! \brief Fill the buffer in parallel, every thread a contiguous chunk
+	 *
+	 * The bytes [0,n_cpy) are copied from src, the bytes [n_cpy,n_set) are set to c. On a new
+	 * mapping the rest of the pages covering the buffer are touched, the pages of the mapping
+	 * after the buffer are left untouched (not committed)
+	 *
+	 * \param src source of the copy
+	 * \param n_cpy bytes to copy
+	 * \param c byte to set
+	 * \param n_set end of the bytes to set
+	 * \param touch true for a new mapping
+	 *
+	 */
+	void par_fill(const void * src, size_t n_cpy, unsigned char c, size_t n_set, bool touch)
+	{
+		unsigned char * dst = static_cast<unsigned char *>(buf);
+		const unsigned char * s = static_cast<const unsigned char *>(src);
+
+		n_set = (n_set > n_cpy)?n_set:n_cpy;
+		size_t n = (touch == true)?round_page(sz,HUGE_PAGE_BASE_SIZE):n_set;
+		int nt = (msz == 0)?openfpm::cpu_num_threads_for(n / 64):openfpm::cpu_num_threads();
+
+		#pragma omp parallel num_threads(nt)
+		{
+			size_t start;
+			size_t stop;
+			openfpm::cpu_chunk(n,openfpm::cpu_team_size(),openfpm::cpu_thread_id(),start,stop);
+
+			size_t e = (stop < n_cpy)?stop:n_cpy;
+			if (start < e)	{std::memcpy(dst + start,s + start,e - start);}
+
+			size_t bs = (start > n_cpy)?start:n_cpy;
+			size_t es = (stop < n_set)?stop:n_set;
+			if (bs < es)	{std::memset(dst + bs,c,es - bs);}
+
+			// touch the rest of the pages (the mapping is already zero)
+
+			size_t bt = (start > n_set)?start:n_set;
+			bt = (bt + HUGE_PAGE_BASE_SIZE - 1) / HUGE_PAGE_BASE_SIZE * HUGE_PAGE_BASE_SIZE;
+			for (size_t i = bt ; i < stop && touch == true ; i += HUGE_PAGE_BASE_SIZE)
+			{dst[i] = 0;}
+		}
+	}
+
+	/*! \brief Get a new buffer
+	 *
+	 * \param sz size in bytes
+	 * \param ptr buffer (output)
+	 * \param msz size of the mapping, 0 if from the heap (output)
+	 * \param htlb true if mapped with MAP_HUGETLB (output)
+	 *
+	 * \return true if success
+	 *
+	 */
+	static bool get_buffer(size_t sz, void * & ptr, size_t & msz, bool & htlb)
+	{
+		htlb = false;
+
+		if (sz < HUGE_PAGE_MIN_SIZE)
+		{
+			msz = 0;
+			return posix_memalign(&ptr,64,(sz == 0)?1:sz) == 0;
+		}
+
+		ptr = map(sz,msz,htlb);
+
+		if (ptr == NULL)	{return false;}
+
+		place(ptr,msz);
+
+		return true;
+	}
+
+	/*! \brief Free a buffer
+	 *
+	 * \param ptr buffer
+	 * \param msz size of the mapping, 0 if from the heap
+	 *
+	 */
+	static void free_buffer(void * ptr, size_t msz)
+	{
+		if (ptr == NULL)	{return;}
+
+		if (msz == 0)	{::free(ptr);}
+		else	{munmap(ptr,msz);}
+	}
+
+public:
+
+	/*! \brief Set the NUMA nodes used by NUMA_BIND
+	 *
+	 * \param mask bit i set means node i (default node 0)
+	 *
+	 */
+	static void setBindNodes(unsigned long mask)
+	{
+		bind_nodes() = mask;
+	}
+
+	/*! \brief Return true if the buffer is mapped on huge pages from the pre-reserved pool (MAP_HUGETLB)
+	 *
+	 * If false a large buffer can still use transparent huge pages
+	 *
+	 * \return true if MAP_HUGETLB is used
+	 *
+	 */
+	bool isHugeTLB() const
+	{
+		return hugetlb;
+	}
+
+	/*! \brief Return the size of the mapping
+	 *
+	 * \return the size of the mapping in bytes, 0 if the buffer come from the heap
+	 *
+	 */
+	size_t getMappedSize() const
+	{
+		return msz;
+	}
+
+	/*! \brief Allocate sz bytes
+	 *
+	 * \param sz size in bytes
+	 *
+	 * \return true if success
+	 *
+	 */
+	virtual bool allocate(size_t sz)
+	{
+		destroy();
+
+		if (get_buffer(sz,buf,msz,hugetlb) == false)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error failed to allocate " << sz << " bytes" << std::endl;
+			buf = NULL;
+			return false;
+		}
+
+		this->sz = sz;
+
+		if (msz != 0)	{par_fill(NULL,0,0,0,true);}
+
+		return true;
+	}
+
+	/*! \brief Free the buffer
+	 *
+	 */
+	virtual void destroy()
+	{
+		free_buffer(buf,msz);
+
+		buf = NULL;
+		sz = 0;
+		msz = 0;
+		hugetlb = false;
+	}
+
+	/*! \brief Copy the content of another memory, resize if needed
+	 *
+	 * \param m memory to copy
+	 *
+	 * \return true if success
+	 *
+	 */
+	virtual bool copy(const memory & m)
+	{
+		if (m.size() > sz && resize(m.size()) == false)
+		{return false;}
+
+		if (m.size() != 0)
+		{par_fill(m.getPointer(),m.size(),0,0,false);}
+
+		return true;
+	}
+
+	/*! \brief Return the size of the memory
+	 *
+	 * \return the size in bytes
+	 *
+	 */
+	virtual size_t size() const
+	{
+		return sz;
+	}
+
+	/*! \brief Resize the memory, the content is preserved
+	 *
+	 * \param sz new size in bytes
+	 *
+	 * \return true if success
+	 *
+	 */
+	virtual bool resize(size_t sz)
+	{
+		if (sz <= this->sz)	{return true;}
+
+		if (buf != NULL && msz != 0 && sz <= msz)
+		{
+			this->sz = sz;
+			return true;
+		}
+
+		void * nbuf;
+		size_t nmsz;
+		bool nhtlb;
+
+		if (get_buffer(sz,nbuf,nmsz,nhtlb) == false)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error failed to allocate " << sz << " bytes" << std::endl;
+			return false;
+		}
+
+		void * old = buf;
+		size_t old_sz = this->sz;
+		size_t old_msz = msz;
+
+		buf = nbuf;
+		msz = nmsz;
+		hugetlb = nhtlb;
+		this->sz = sz;
+
+		par_fill(old,old_sz,0,0,msz != 0);
+
+		free_buffer(old,old_msz);
+
+		return true;
+	}
+
+	/*! \brief Return the pointer to the memory
+	 *
+	 * \return the pointer
+	 *
+	 */
+	virtual void * getPointer()
+	{
+		return buf;
+	}
+
+	/*! \brief Return the pointer to the memory
+	 *
+	 * \return the pointer
+	 *
+	 */
+	virtual const void * getPointer() const
+	{
+		return buf;
+	}
+
+	/*! \brief Return the pointer to the memory (on host it is the same)
+	 *
+	 * \return the pointer
+	 *
+	 */
+	virtual void * getDevicePointer()
+	{
+		return buf;
+	}
+
+	/*! \brief Fill the memory with a byte, in parallel
+	 *
+	 * \param c byte
+	 *
+	 */
+	virtual void fill(unsigned char c)
+	{
+		if (buf != NULL)
+		{par_fill(NULL,0,c,sz,false);}
+	}
+
+	/*! \brief Swap the memory with another HugePageMemory
+	 *
+	 * \param mem memory to swap
+	 *
+	 */
+	void swap(HugePageMemory & mem)
+	{
+		std::swap(buf,mem.buf);
+		std::swap(sz,mem.sz);
+		std::swap(msz,mem.msz);
+		std::swap(hugetlb,mem.hugetlb);
+	}
+
+	/*! \brief Copy the memory
+	 *
+	 * \param mem memory to copy
+	 *
+	 * \return itself
+	 *
+	 */
+	HugePageMemory & operator=(const HugePageMemory & mem)
+	{
+		if (this != &mem)
+		{
+			destroy();
+			copy(mem);
+		}
+
+		return *this;
+	}
+
+	/*! \brief Move the memory
+	 *
+	 * \param mem memory to move
+	 *
+	 * \return itself
+	 *
+	 */
+	HugePageMemory & operator=(HugePageMemory && mem)
+	{
+		swap(mem);
+
+		return *this;
+	}
+
+	//! Constructor
+	HugePageMemory()
+	:HeapMemory(),buf(NULL),sz(0),msz(0),hugetlb(false)
+	{}
+
+	/*! \brief Copy constructor
+	 *
+	 * \param mem memory to copy
+	 *
+	 */
+	HugePageMemory(const HugePageMemory & mem)
+	:HeapMemory(),buf(NULL),sz(0),msz(0),hugetlb(false)
+	{
+		copy(mem);
+	}
+
+	/*! \brief Move constructor
+	 *
+	 * \param mem memory to move
+	 *
+	 */
+	HugePageMemory(HugePageMemory && mem)
+	:HeapMemory(),buf(NULL),sz(0),msz(0),hugetlb(false)
+	{
+		swap(mem);
+	}
+
+	//! Destructor
+	virtual ~HugePageMemory() noexcept
+	{
+		destroy();
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_MEMORY_LY_HUGEPAGEMEMORY_HPP_ */
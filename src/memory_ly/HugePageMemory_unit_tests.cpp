@@ -0,0 +1,151 @@
+#define DISABLE_MPI_WRITTERS
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "memory_ly/HugePageMemory.hpp"
+#include "Vector/map_vector.hpp"
+#include "Grid/map_grid.hpp"
+#include "SparseGrid/SparseGrid.hpp"
+
+BOOST_AUTO_TEST_SUITE( huge_page_memory_test )
+
+template<typename vector_type>
+void test_huge_page_vector()
+{
+	vector_type v;
+
+	// it cross HUGE_PAGE_MIN_SIZE, from heap to mapped buffers
+
+	for (size_t i = 0 ; i < 1000000 ; i++)
+	{
+		v.add();
+		v.template get<0>(v.size()-1) = i;
+		v.template get<1>(v.size()-1)[0] = i + 1;
+		v.template get<1>(v.size()-1)[1] = i + 2;
+	}
+
+	vector_type v2 = v;
+
+	bool match = true;
+	for (size_t i = 0 ; i < v2.size() ; i++)
+	{
+		match &= v2.template get<0>(i) == i;
+		match &= v2.template get<1>(i)[0] == i + 1;
+		match &= v2.template get<1>(i)[1] == i + 2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE( huge_page_memory_vector )
+{
+	test_huge_page_vector<openfpm::vector<aggregate<size_t,size_t[2]>,HugePageMemory<>>>();
+	test_huge_page_vector<openfpm::vector<aggregate<size_t,size_t[2]>,HugePageMemory<NUMA_INTERLEAVE,HUGE_PAGE_1G>,memory_traits_inte>>();
+	test_huge_page_vector<openfpm::vector<aggregate<size_t,size_t[2]>,HugePageMemory<NUMA_BIND,HUGE_PAGE_NONE>>>();
+}
+
+BOOST_AUTO_TEST_CASE( huge_page_memory_mapping_size )
+{
+	// below 1 GB the 1 GB pages are not used, the mapping is rounded to 2 MB
+
+	HugePageMemory<NUMA_INTERLEAVE,HUGE_PAGE_1G> m1;
+	m1.allocate(3*HUGE_PAGE_MIN_SIZE + 5);
+
+	BOOST_REQUIRE_EQUAL(m1.size(),3*HUGE_PAGE_MIN_SIZE + 5);
+	BOOST_REQUIRE_EQUAL(m1.getMappedSize(),2*HUGE_PAGE_2M_SIZE);
+
+	m1.resize(7*HUGE_PAGE_MIN_SIZE);
+	BOOST_REQUIRE_EQUAL(m1.getMappedSize(),4*HUGE_PAGE_2M_SIZE);
+
+	HugePageMemory<NUMA_FIRST_TOUCH,HUGE_PAGE_NONE> m2;
+	m2.allocate(HUGE_PAGE_MIN_SIZE + 5);
+	BOOST_REQUIRE_EQUAL(m2.getMappedSize(),HUGE_PAGE_MIN_SIZE + HUGE_PAGE_BASE_SIZE);
+
+	// small buffers come from the heap
+
+	HugePageMemory<> m3;
+	m3.allocate(1000);
+	BOOST_REQUIRE_EQUAL(m3.getMappedSize(),0ul);
+}
+
+BOOST_AUTO_TEST_CASE( huge_page_memory_grid )
+{
+	size_t sz[3] = {128,128,128};
+
+	grid_base<3,aggregate<float,float[3]>,HugePageMemory<>> g1(sz);
+	g1.setMemory();
+
+	auto it = g1.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g1.template get<0>(key) = key.get(0) + key.get(1) + key.get(2);
+		g1.template get<1>(key)[0] = key.get(0);
+		g1.template get<1>(key)[1] = key.get(1);
+		g1.template get<1>(key)[2] = key.get(2);
+
+		++it;
+	}
+
+	grid_base<3,aggregate<float,float[3]>,HugePageMemory<>> g2;
+	g2 = g1.duplicate();
+
+	bool match = true;
+	auto it2 = g2.getIterator();
+
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		match &= g2.template get<0>(key) == key.get(0) + key.get(1) + key.get(2);
+		match &= g2.template get<1>(key)[0] == key.get(0);
+		match &= g2.template get<1>(key)[1] == key.get(1);
+		match &= g2.template get<1>(key)[2] == key.get(2);
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE( huge_page_memory_sparse_grid )
+{
+	size_t sz[3] = {171,171,171};
+
+	sgrid_cpu<3,aggregate<float>,HugePageMemory<>> grid(sz);
+
+	grid.getBackgroundValue().template get<0>() = 0.0;
+
+	grid_sm<3,void> g_sm(sz);
+	grid_key_dx_iterator<3> it(g_sm);
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		grid.template insert<0>(key) = g_sm.LinId(key);
+
+		++it;
+	}
+
+	bool match = true;
+	size_t count = 0;
+	auto it2 = grid.getIterator();
+
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		match &= grid.template get<0>(key) == (float)g_sm.LinId(key);
+		count++;
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE_EQUAL(count,(size_t)171*171*171);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
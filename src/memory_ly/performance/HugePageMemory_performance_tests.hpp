@@ -0,0 +1,185 @@
+/*
+ * HugePageMemory_performance_tests.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_MEMORY_LY_PERFORMANCE_HUGEPAGEMEMORY_PERFORMANCE_TESTS_HPP_
+#define OPENFPM_DATA_SRC_MEMORY_LY_PERFORMANCE_HUGEPAGEMEMORY_PERFORMANCE_TESTS_HPP_
+
+#include "memory_ly/HugePageMemory.hpp"
+#include "Grid/map_grid.hpp"
+#include "NN/CellList/CellList.hpp"
+#include "util/stat/common_statistics.hpp"
+#include <random>
+
+// Property tree
+struct report_huge_page_func_tests
+{
+	boost::property_tree::ptree graphs;
+};
+
+report_huge_page_func_tests report_hp_funcs;
+
+BOOST_AUTO_TEST_SUITE( huge_page_memory_performance )
+
+/*! \brief Measure duplicate and element-wise copy of a grid with a Memory type
+ *
+ * duplicate include the allocation (page faults), the copy work on already allocated grids
+ *
+ * \param name name of the memory type in the report
+ * \param k id of the test in the report
+ *
+ */
+template<typename Memory>
+void huge_page_grid_copy(const std::string & name, size_t k)
+{
+	size_t sz[] = {256,256,256};
+
+	grid_base<3,aggregate<float,float[3]>,Memory> c3(sz);
+	c3.setMemory();
+
+	auto it = c3.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		c3.template get<0>(key) = key.get(0);
+		c3.template get<1>(key)[0] = key.get(1);
+		c3.template get<1>(key)[1] = key.get(2);
+		c3.template get<1>(key)[2] = key.get(0);
+
+		++it;
+	}
+
+	grid_base<3,aggregate<float,float[3]>,Memory> c1(sz);
+	c1.setMemory();
+
+	std::vector<double> times_dup(N_STAT_SMALL + 1);
+	std::vector<double> times_cpy(N_STAT_SMALL + 1);
+
+	for (size_t i = 0 ; i < N_STAT_SMALL+1 ; i++)
+	{
+		timer t;
+		t.start();
+
+		grid_base<3,aggregate<float,float[3]>,Memory> c2;
+		c2 = c3.duplicate();
+
+		t.stop();
+		times_dup[i] = t.getwct();
+
+		timer tc;
+		tc.start();
+
+		auto it2 = c3.getIterator();
+
+		while (it2.isNext())
+		{
+			c1.set(it2.get(),c3,it2.get());
+
+			++it2;
+		}
+
+		tc.stop();
+		times_cpy[i] = tc.getwct();
+	}
+
+	double mean;
+	double dev;
+
+	std::string base = "performance.huge_page.grid(" + std::to_string(k) + ")";
+
+	report_hp_funcs.graphs.put(base + ".name",name);
+
+	standard_deviation(times_dup,mean,dev);
+	report_hp_funcs.graphs.put(base + ".dup.data.mean",mean);
+	report_hp_funcs.graphs.put(base + ".dup.data.dev",dev);
+
+	std::cout << "Grid " << name << "  duplicate: " << mean << " +- " << dev;
+
+	standard_deviation(times_cpy,mean,dev);
+	report_hp_funcs.graphs.put(base + ".copy.data.mean",mean);
+	report_hp_funcs.graphs.put(base + ".copy.data.dev",dev);
+
+	std::cout << "  copy: " << mean << " +- " << dev << std::endl;
+}
+
+/*! \brief Measure the fill of a cell-list where particles and cell-list use a Memory type
+ *
+ * \param name name of the memory type in the report
+ * \param k id of the test in the report
+ *
+ */
+template<typename Memory>
+void huge_page_cell_list_fill(const std::string & name, size_t k)
+{
+	SpaceBox<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {128,128,128};
+
+	std::default_random_engine eg;
+	std::uniform_real_distribution<double> ud(0.0,1.0);
+
+	openfpm::vector<Point<3,double>,Memory> pos;
+
+	for (size_t i = 0 ; i < 8000000 ; i++)
+	{pos.add(Point<3,double>({ud(eg),ud(eg),ud(eg)}));}
+
+	std::vector<double> times(N_STAT_SMALL + 1);
+
+	for (size_t i = 0 ; i < N_STAT_SMALL+1 ; i++)
+	{
+		CellList<3,double,Mem_fast<Memory>> cl(box,div);
+
+		timer t;
+		t.start();
+
+		cl.fill(pos,pos.size());
+
+		t.stop();
+		times[i] = t.getwct();
+	}
+
+	double mean;
+	double dev;
+
+	std::string base = "performance.huge_page.cell_list(" + std::to_string(k) + ")";
+
+	report_hp_funcs.graphs.put(base + ".name",name);
+
+	standard_deviation(times,mean,dev);
+	report_hp_funcs.graphs.put(base + ".fill.data.mean",mean);
+	report_hp_funcs.graphs.put(base + ".fill.data.dev",dev);
+
+	std::cout << "Cell-list " << name << "  fill: " << mean << " +- " << dev << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(huge_page_memory_performance_grid)
+{
+	huge_page_grid_copy<HeapMemory>("HeapMemory",0);
+	huge_page_grid_copy<HugePageMemory<NUMA_FIRST_TOUCH,HUGE_PAGE_NONE>>("first_touch",1);
+	huge_page_grid_copy<HugePageMemory<NUMA_FIRST_TOUCH,HUGE_PAGE_2M>>("first_touch_2M",2);
+	huge_page_grid_copy<HugePageMemory<NUMA_INTERLEAVE,HUGE_PAGE_2M>>("interleave_2M",3);
+}
+
+BOOST_AUTO_TEST_CASE(huge_page_memory_performance_cell_list)
+{
+	huge_page_cell_list_fill<HeapMemory>("HeapMemory",0);
+	huge_page_cell_list_fill<HugePageMemory<NUMA_FIRST_TOUCH,HUGE_PAGE_NONE>>("first_touch",1);
+	huge_page_cell_list_fill<HugePageMemory<NUMA_FIRST_TOUCH,HUGE_PAGE_2M>>("first_touch_2M",2);
+	huge_page_cell_list_fill<HugePageMemory<NUMA_INTERLEAVE,HUGE_PAGE_2M>>("interleave_2M",3);
+}
+
+/////// THIS IS NOT A TEST IT WRITE THE PERFORMANCE RESULT ///////
+
+BOOST_AUTO_TEST_CASE(huge_page_memory_performance_write_report)
+{
+	boost::property_tree::xml_writer_settings<std::string> settings(' ', 4);
+	boost::property_tree::write_xml("huge_page_memory_performance_funcs.xml", report_hp_funcs.graphs,std::locale(),settings);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* OPENFPM_DATA_SRC_MEMORY_LY_PERFORMANCE_HUGEPAGEMEMORY_PERFORMANCE_TESTS_HPP_ */
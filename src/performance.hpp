@@ -34,6 +34,8 @@ BOOST_AUTO_TEST_SUITE( performance )
 //// Include tests ////////
 
 #include "Grid/performance/grid_performance_tests.hpp"
+#include "NN/CellList/performance/CellList_performance_tests.hpp"
+#include "memory_ly/performance/HugePageMemory_performance_tests.hpp"
 
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,481 @@
+/*
+ * cpu_parallel_util.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef CPU_PARALLEL_UTIL_HPP_
+#define CPU_PARALLEL_UTIL_HPP_
+
+#include <cstring>
+#include <utility>
+#include <type_traits>
+#include <vector>
+
+#include "config.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if defined(HAVE_OPENMP) && !defined(_OPENMP) && !defined(__CUDA_ARCH__)
+#warning "openfpm_data has been configured with OpenMP but this file is compiled without the OpenMP flags, the CPU parallel algorithms run serial"
+#endif
+
+namespace openfpm
+{
+	/*! \brief Return the number of threads available for a parallel region
+	 *
+	 * \return the number of threads (1 if compiled without OpenMP)
+	 *
+	 */
+	inline int cpu_num_threads()
+	{
+#ifdef _OPENMP
+		return omp_get_max_threads();
+#else
+		return 1;
+#endif
+	}
+
+	/*! \brief Return the id of the calling thread inside a parallel region
+	 *
+	 * \return the thread id (0 if compiled without OpenMP)
+	 *
+	 */
+	inline int cpu_thread_id()
+	{
+#ifdef _OPENMP
+		return omp_get_thread_num();
+#else
+		return 0;
+#endif
+	}
+
+	/*! \brief Return the number of threads of the current parallel region
+	 *
+	 * \return the number of threads in the team (1 if compiled without OpenMP)
+	 *
+	 */
+	inline int cpu_team_size()
+	{
+#ifdef _OPENMP
+		return omp_get_num_threads();
+#else
+		return 1;
+#endif
+	}
+
+	/*! \brief Split the range [0,n) into nt contiguous chunks and return the chunk t
+	 *
+	 * \param n size of the range
+	 * \param nt number of chunks
+	 * \param t chunk id
+	 * \param start start of the chunk
+	 * \param stop stop of the chunk (excluded)
+	 *
+	 */
+	inline void cpu_chunk(size_t n, int nt, int t, size_t & start, size_t & stop)
+	{
+		size_t sz = n / nt;
+		size_t rm = n % nt;
+
+		start = t*sz + ((size_t)t < rm?t:rm);
+		stop = start + sz + ((size_t)t < rm?1:0);
+	}
+
+	//! Default minimum number of elements per thread
+	constexpr size_t cpu_parallel_grain_default = 16384;
+
+	/*! \brief Minimum number of elements per thread, under this the primitives run serial
+	 *
+	 * Spawning threads has a cost, for small arrays is better to stay serial. It can be lowered
+	 * (for example by the tests) to run the parallel code paths on small inputs
+	 *
+	 * \return a reference to the grain
+	 *
+	 */
+	inline size_t & cpu_parallel_grain()
+	{
+		static size_t grain = cpu_parallel_grain_default;
+
+		return grain;
+	}
+
+	/*! \brief Return the number of threads to use to process n elements
+	 *
+	 * \param n number of elements
+	 *
+	 * \return the number of threads
+	 *
+	 */
+	inline int cpu_num_threads_for(size_t n)
+	{
+		size_t nt = n / cpu_parallel_grain();
+		size_t mt = cpu_num_threads();
+
+		if (nt > mt)	{nt = mt;}
+		if (nt == 0)	{nt = 1;}
+
+		return nt;
+	}
+
+	/*! \brief Exclusive prefix sum on CPU with a blocked parallel algorithm
+	 *
+	 * The input is divided in one contiguous block per thread, every thread
+	 * reduce its block, the block sums are scanned and finally every thread
+	 * scan its block starting from its offset. Input and output can alias
+	 *
+	 * \param input input iterator
+	 * \param count number of elements
+	 * \param output output iterator
+	 *
+	 */
+	template<typename input_it, typename output_it>
+	void cpu_scan(input_it input, size_t count, output_it output)
+	{
+		typedef typename std::remove_reference<decltype(output[0])>::type out_type;
+		typedef typename std::remove_const<out_type>::type T;
+
+		if (count == 0)	{return;}
+
+		int nt = cpu_num_threads_for(count);
+
+		std::vector<T> block_sum(nt+1);
+		block_sum[0] = 0;
+
+		#pragma omp parallel num_threads(nt)
+		{
+			int t = cpu_thread_id();
+			int tsz = cpu_team_size();
+
+			size_t start;
+			size_t stop;
+			cpu_chunk(count,tsz,t,start,stop);
+
+			T sum = 0;
+			for (size_t i = start ; i < stop ; i++)
+			{sum += input[i];}
+
+			block_sum[t+1] = sum;
+
+			#pragma omp barrier
+
+			#pragma omp single
+			{
+				for (int i = 1 ; i <= tsz ; i++)
+				{block_sum[i] += block_sum[i-1];}
+			}
+
+			T acc = block_sum[t];
+			for (size_t i = start ; i < stop ; i++)
+			{
+				T in = input[i];
+				output[i] = acc;
+				acc += in;
+			}
+		}
+	}
+
+	/*! \brief Reduction on CPU with a tree algorithm
+	 *
+	 * Every thread reduce a contiguous block, the partial results are combined
+	 * pairwise in log2(nthreads) steps
+	 *
+	 * \param input input iterator
+	 * \param count number of elements
+	 * \param op reduction operation
+	 *
+	 * \return the reduced value (0 if count is zero)
+	 *
+	 */
+	template<typename T, typename input_it, typename reduce_op>
+	T cpu_reduce(input_it input, size_t count, reduce_op op)
+	{
+		if (count == 0)	{return 0;}
+
+		int nt = cpu_num_threads_for(count);
+
+		std::vector<T> partial(nt);
+
+		#pragma omp parallel num_threads(nt)
+		{
+			int t = cpu_thread_id();
+			int tsz = cpu_team_size();
+
+			size_t start;
+			size_t stop;
+			cpu_chunk(count,tsz,t,start,stop);
+
+			if (start < stop)
+			{
+				T red = input[start];
+				for (size_t i = start + 1 ; i < stop ; i++)
+				{red = op(red,input[i]);}
+
+				partial[t] = red;
+			}
+
+			// tree combination
+			for (int s = 1 ; s < tsz ; s *= 2)
+			{
+				#pragma omp barrier
+
+				if (t % (2*s) == 0 && t + s < tsz)
+				{
+					size_t st2;
+					size_t sp2;
+					cpu_chunk(count,tsz,t+s,st2,sp2);
+
+					if (st2 < sp2)
+					{partial[t] = op(partial[t],partial[t+s]);}
+				}
+			}
+		}
+
+		return partial[0];
+	}
+
+	/*! \brief Convert a key into an unsigned integer that preserve the ordering
+	 *
+	 * Unsigned integers are returned as they are, signed integers have the sign bit
+	 * flipped, floating points are flipped following the IEEE 754 layout
+	 *
+	 */
+	template<typename key_t, bool is_float = std::is_floating_point<key_t>::value, bool is_signed = std::is_signed<key_t>::value>
+	struct radix_key
+	{
+		typedef typename std::make_unsigned<key_t>::type ukey_t;
+
+		static inline ukey_t to_bits(const key_t & k)
+		{
+			return (ukey_t)k;
+		}
+	};
+
+	//! signed integer key
+	template<typename key_t>
+	struct radix_key<key_t,false,true>
+	{
+		typedef typename std::make_unsigned<key_t>::type ukey_t;
+
+		static inline ukey_t to_bits(const key_t & k)
+		{
+			return ((ukey_t)k) ^ ((ukey_t)1 << (sizeof(ukey_t)*8 - 1));
+		}
+	};
+
+	//! floating point key
+	template<typename key_t>
+	struct radix_key<key_t,true,true>
+	{
+		typedef typename std::conditional<sizeof(key_t) == 4,unsigned int,unsigned long int>::type ukey_t;
+
+		static inline ukey_t to_bits(const key_t & k)
+		{
+			ukey_t u;
+			std::memcpy(&u,&k,sizeof(key_t));
+
+			ukey_t sign = (ukey_t)1 << (sizeof(ukey_t)*8 - 1);
+			return (u & sign)?~u:(u | sign);
+		}
+	};
+
+	/*! \brief Check if a key type can be sorted with the radix sort
+	 *
+	 */
+	template<typename key_t>
+	struct is_radix_sortable
+	{
+		static const bool value = (std::is_integral<key_t>::value && !std::is_same<key_t,bool>::value) || (std::is_floating_point<key_t>::value && (sizeof(key_t) == 4 || sizeof(key_t) == 8));
+	};
+
+	/*! \brief Parallel stable LSD radix sort of key/value pairs
+	 *
+	 * Every pass process 8 bits, every thread compute the histogram of its block,
+	 * the histograms are scanned digit by digit and thread by thread (this keep
+	 * the sort stable) and every thread scatter its block. Passes where all the keys
+	 * share the same digit are skipped
+	 *
+	 * \param keys keys to sort
+	 * \param vals values to reorder together with the keys
+	 * \param count number of elements
+	 * \param keys_tmp temporal buffer for the keys (at least count elements)
+	 * \param vals_tmp temporal buffer for the values (at least count elements)
+	 * \param descending true for a descending sort
+	 *
+	 */
+	template<typename key_t, typename val_t>
+	void cpu_radix_sort_pairs(key_t * keys, val_t * vals, size_t count,
+							  key_t * keys_tmp, val_t * vals_tmp, bool descending)
+	{
+		typedef radix_key<key_t> rk;
+		const int n_bucket = 256;
+		const int n_pass = sizeof(key_t);
+
+		if (count <= 1)	{return;}
+
+		int nt = cpu_num_threads_for(count);
+
+		// per thread histogram of the current pass and per thread
+		// histogram of all the passes (used to detect useless passes)
+		std::vector<size_t> hist((size_t)nt*n_bucket);
+		std::vector<size_t> hist_all((size_t)nt*n_bucket*n_pass);
+
+		key_t * k_src = keys;
+		key_t * k_dst = keys_tmp;
+		val_t * v_src = vals;
+		val_t * v_dst = vals_tmp;
+
+		#pragma omp parallel num_threads(nt)
+		{
+			int t = cpu_thread_id();
+			int tsz = cpu_team_size();
+
+			size_t start;
+			size_t stop;
+			cpu_chunk(count,tsz,t,start,stop);
+
+			size_t * ha = &hist_all[(size_t)t*n_bucket*n_pass];
+			for (size_t i = start ; i < stop ; i++)
+			{
+				auto u = rk::to_bits(keys[i]);
+				for (int p = 0 ; p < n_pass ; p++)
+				{ha[p*n_bucket + ((u >> (8*p)) & 0xFF)]++;}
+			}
+
+			#pragma omp barrier
+
+			for (int p = 0 ; p < n_pass ; p++)
+			{
+				// skip the pass if all the keys have the same digit
+
+				bool skip = false;
+				for (int d = 0 ; d < n_bucket ; d++)
+				{
+					size_t tot = 0;
+					for (int j = 0 ; j < tsz ; j++)
+					{tot += hist_all[(size_t)j*n_bucket*n_pass + p*n_bucket + d];}
+
+					if (tot == count)	{skip = true;break;}
+					if (tot != 0)		{break;}
+				}
+
+				if (skip == true)	{continue;}
+
+				size_t * h = &hist[(size_t)t*n_bucket];
+				for (int d = 0 ; d < n_bucket ; d++)
+				{h[d] = 0;}
+
+				for (size_t i = start ; i < stop ; i++)
+				{
+					size_t d = (rk::to_bits(k_src[i]) >> (8*p)) & 0xFF;
+					if (descending == true)	{d = n_bucket - 1 - d;}
+					h[d]++;
+				}
+
+				#pragma omp barrier
+
+				// offset of this thread for every digit
+
+				size_t off[n_bucket];
+				size_t base = 0;
+				for (int d = 0 ; d < n_bucket ; d++)
+				{
+					for (int j = 0 ; j < tsz ; j++)
+					{
+						if (j == t)	{off[d] = base;}
+						base += hist[(size_t)j*n_bucket + d];
+					}
+				}
+
+				for (size_t i = start ; i < stop ; i++)
+				{
+					size_t d = (rk::to_bits(k_src[i]) >> (8*p)) & 0xFF;
+					if (descending == true)	{d = n_bucket - 1 - d;}
+
+					size_t pos = off[d]++;
+					k_dst[pos] = k_src[i];
+					v_dst[pos] = v_src[i];
+				}
+
+				#pragma omp barrier
+
+				#pragma omp single
+				{
+					std::swap(k_src,k_dst);
+					std::swap(v_src,v_dst);
+				}
+			}
+
+			// if the result is in the temporal buffers copy back
+
+			if (k_src != keys)
+			{
+				for (size_t i = start ; i < stop ; i++)
+				{
+					keys[i] = k_src[i];
+					vals[i] = v_src[i];
+				}
+			}
+		}
+	}
+
+	/*! \brief Parallel stable bucketing of the indexes [0,n)
+	 *
+	 * The index i go into the bucket bkt[i]. The output is in CSR format, the bucket b
+	 * contain the indexes ele_out[bkt_start[b]] ... ele_out[bkt_start[b+1]-1] in increasing
+	 * order. The result is the same independently from the number of threads
+	 *
+	 * \param bkt bucket of each index
+	 * \param n number of indexes
+	 * \param n_bkt number of buckets
+	 * \param ele_out indexes ordered by bucket (n elements)
+	 * \param bkt_start start of each bucket in ele_out (n_bkt+1 elements)
+	 *
+	 */
+	template<typename index_t>
+	void cpu_bucket_sort(const index_t * bkt, size_t n, size_t n_bkt, index_t * ele_out, index_t * bkt_start)
+	{
+		if (n == 0)
+		{
+			for (size_t c = 0 ; c <= n_bkt ; c++)
+			{bkt_start[c] = 0;}
+
+			return;
+		}
+
+		std::vector<index_t> keys(n);
+		std::vector<index_t> keys_tmp(n);
+		std::vector<index_t> vals_tmp(n);
+
+		int nt = cpu_num_threads_for(n);
+
+		#pragma omp parallel for num_threads(nt) schedule(static)
+		for (size_t i = 0 ; i < n ; i++)
+		{
+			keys[i] = bkt[i];
+			ele_out[i] = i;
+		}
+
+		cpu_radix_sort_pairs(&keys[0],ele_out,n,&keys_tmp[0],&vals_tmp[0],false);
+
+		// every bucket start is written exactly once, empty buckets
+		// start where the next non empty bucket start
+
+		#pragma omp parallel for num_threads(nt) schedule(static)
+		for (size_t k = 0 ; k <= n ; k++)
+		{
+			size_t c_prev = (k == 0)?0:(size_t)keys[k-1]+1;
+			size_t c_next = (k == n)?n_bkt:(size_t)keys[k];
+
+			if (k != 0 && k != n && keys[k] == keys[k-1])	{continue;}
+
+			for (size_t c = c_prev ; c <= c_next ; c++)
+			{bkt_start[c] = k;}
+		}
+	}
+}
+
+#endif /* CPU_PARALLEL_UTIL_HPP_ */
@@ -30,6 +30,8 @@ namespace mgpu
 			std::string _props;
 
 			openfpm::vector<aggregate<unsigned char>> tmem;
+			openfpm::vector<aggregate<unsigned char>> tmem2;
+			openfpm::vector<aggregate<unsigned char>> tmem3;
 
 			// Making this a template argument means we won't generate an instance
 			// of dummy_k for each translation unit.
@@ -105,6 +107,21 @@ namespace mgpu
 				std::cout << __FILE__ << ":" << __LINE__ << " Not implemented"  << std::endl;
 				return 0;
 			}
+
+			openfpm::vector<aggregate<unsigned char>> & getTemporalCUB()
+			{
+				return tmem;
+			}
+
+			openfpm::vector<aggregate<unsigned char>> & getTemporalCUB2()
+			{
+				return tmem2;
+			}
+
+			openfpm::vector<aggregate<unsigned char>> & getTemporalCUB3()
+			{
+				return tmem3;
+			}
 	};
 
 }
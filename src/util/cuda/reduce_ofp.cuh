@@ -28,6 +28,10 @@
 
 #include "util/cuda/ofp_context.hxx"
 
+#ifdef CUDA_ON_CPU
+#include "util/cpu_parallel_util.hpp"
+#endif
+
 namespace openfpm
 {
 	template<typename input_it, typename output_it, typename reduce_op>
@@ -35,11 +39,9 @@ namespace openfpm
 	{
 #ifdef CUDA_ON_CPU
 
-	output[0] = 0;
-	for (int i = 0 ; i < count ; i++)
-	{
-		output[0] = op(output[0],input[i]);
-	}
+	typedef typename std::remove_reference<decltype(output[0])>::type red_type;
+
+	output[0] = openfpm::cpu_reduce<red_type>(input,count,op);
 
 #else
 	#ifdef REDUCE_WITH_CUB
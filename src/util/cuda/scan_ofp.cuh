@@ -27,6 +27,10 @@
 #endif
 #include "util/cuda/ofp_context.hxx"
 
+#ifdef CUDA_ON_CPU
+#include "util/cpu_parallel_util.hpp"
+#endif
+
 namespace openfpm
 {
 	template<typename input_it, typename output_it>
@@ -34,16 +38,7 @@ namespace openfpm
 	{
 #ifdef CUDA_ON_CPU
 
-	if (count == 0)	{return;}
-
-	auto prec = input[0];
-	output[0] = 0;
-	for (int i = 1 ; i < count ; i++)
-	{
-		auto next = prec + output[i-1];
-		prec = input[i];
-		output[i] = next;
-	}
+	openfpm::cpu_scan(input,count,output);
 
 #else
 	#ifdef SCAN_WITH_CUB
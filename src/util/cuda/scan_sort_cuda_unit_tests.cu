@@ -13,6 +13,7 @@
 
 #include "sort_ofp.cuh"
 #include "scan_ofp.cuh"
+#include "reduce_ofp.cuh"
 
 BOOST_AUTO_TEST_SUITE( scan_tests )
 
@@ -109,4 +110,98 @@ BOOST_AUTO_TEST_CASE( test_sort_cub_wrapper )
 	// Test the cell list
 }
 
+BOOST_AUTO_TEST_CASE( test_reduce_cub_wrapper )
+{
+	openfpm::vector_gpu<aggregate<unsigned int>> input;
+	openfpm::vector_gpu<aggregate<unsigned int>> output;
+
+	input.resize(1000000);
+	output.resize(1);
+
+	// fill input
+
+	size_t sum = 0;
+	for (size_t i = 0 ; i < input.size() ; i++)
+	{
+		input.template get<0>(i) = 10.0*(float)rand() / RAND_MAX;
+		sum += input.template get<0>(i);
+	}
+
+	input.template hostToDevice<0>();
+
+	mgpu::ofp_context_t context;
+	openfpm::reduce((unsigned int *)input.template getDeviceBuffer<0>(),input.size(),
+					(unsigned int *)output.template getDeviceBuffer<0>(),
+					mgpu::plus_t<unsigned int>(),context);
+
+	output.template deviceToHost<0>();
+
+	BOOST_REQUIRE_EQUAL(output.template get<0>(0),sum);
+}
+
+BOOST_AUTO_TEST_CASE( test_scan_sort_large_wrapper )
+{
+	openfpm::vector_gpu<aggregate<unsigned int>> input;
+	openfpm::vector_gpu<aggregate<unsigned int>> input_id;
+	openfpm::vector_gpu<aggregate<unsigned int>> input_cp;
+
+	input.resize(1000000);
+	input_id.resize(1000000);
+
+	// fill input, small keys range create a lot of equal keys
+
+	for (size_t i = 0 ; i < input.size() ; i++)
+	{
+		input.template get<0>(i) = 1000.0*(float)rand() / RAND_MAX;
+		input_id.template get<0>(i) = i;
+	}
+
+	input_cp = input;
+
+	input.template hostToDevice<0>();
+	input_id.template hostToDevice<0>();
+
+	mgpu::ofp_context_t context;
+
+	openfpm::sort((unsigned int *)input.template getDeviceBuffer<0>(),
+				  (unsigned int *)input_id.template getDeviceBuffer<0>(),
+			      input.size(),mgpu::template less_t<unsigned int>(),context);
+
+	input.template deviceToHost<0>();
+	input_id.template deviceToHost<0>();
+
+	// the sort must be stable and the values must follow the keys
+
+	for (size_t i = 0 ; i < input.size() - 1 ; i++)
+	{
+		BOOST_REQUIRE(input.template get<0>(i) <= input.template get<0>(i+1));
+
+		if (input.template get<0>(i) == input.template get<0>(i+1))
+		{BOOST_REQUIRE(input_id.template get<0>(i) < input_id.template get<0>(i+1));}
+	}
+
+	for (size_t i = 0 ; i < input.size() ; i++)
+	{
+		BOOST_REQUIRE_EQUAL(input.template get<0>(i),input_cp.template get<0>(input_id.template get<0>(i)));
+	}
+
+	// in place scan
+
+	openfpm::vector<aggregate<unsigned int>> input_orig;
+	input_orig.resize(input_cp.size());
+	for (size_t i = 0 ; i < input_cp.size() ; i++)
+	{input_orig.template get<0>(i) = input_cp.template get<0>(i);}
+
+	input_cp.template hostToDevice<0>();
+	openfpm::scan((unsigned int *)input_cp.template getDeviceBuffer<0>(),input_cp.size(),(unsigned int *)input_cp.template getDeviceBuffer<0>(),context);
+	input_cp.template deviceToHost<0>();
+
+	size_t cnt = 0;
+	for (size_t i = 0 ; i < input.size() ; i++)
+	{
+		BOOST_REQUIRE_EQUAL(cnt,input_cp.template get<0>(i));
+		cnt += input_orig.template get<0>(i);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
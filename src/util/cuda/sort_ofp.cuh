@@ -29,6 +29,10 @@
 
 #include "util/cuda/ofp_context.hxx"
 
+#ifdef CUDA_ON_CPU
+#include "util/cpu_parallel_util.hpp"
+#endif
+
 template<typename key_t, typename val_t>
 struct key_val_ref;
 
@@ -231,6 +235,61 @@ namespace std
 }
 
 
+#ifdef CUDA_ON_CPU
+
+/*! \brief Sort on CPU for key types that cannot be radix sorted
+ *
+ */
+template<bool is_radix>
+struct sort_cpu_impl
+{
+	template<typename key_t, typename val_t, typename comp_t>
+	static void sort(key_t* keys_input, val_t* vals_input, int count,
+					 comp_t comp, mgpu::ofp_context_t& context)
+	{
+		key_val_it<key_t,val_t> kv(keys_input,vals_input);
+
+		std::sort(kv,kv+count,comp);
+	}
+};
+
+/*! \brief Sort on CPU for integral and floating point keys
+ *
+ * less_t and greater_t comparators use the parallel radix sort, any other comparator
+ * fall back to std::sort
+ *
+ */
+template<>
+struct sort_cpu_impl<true>
+{
+	template<typename key_t, typename val_t, typename comp_t>
+	static void sort(key_t* keys_input, val_t* vals_input, int count,
+					 comp_t comp, mgpu::ofp_context_t& context)
+	{
+		bool is_less = std::is_same<mgpu::template less_t<key_t>,comp_t>::value;
+		bool is_greater = std::is_same<mgpu::template greater_t<key_t>,comp_t>::value;
+
+		if (is_less == false && is_greater == false)
+		{
+			sort_cpu_impl<false>::sort(keys_input,vals_input,count,comp,context);
+			return;
+		}
+
+		auto & temporal2 = context.getTemporalCUB2();
+		temporal2.resize(sizeof(key_t)*count);
+
+		auto & temporal3 = context.getTemporalCUB3();
+		temporal3.resize(sizeof(val_t)*count);
+
+		openfpm::cpu_radix_sort_pairs(keys_input,vals_input,count,
+									  (key_t *)temporal2.template getDeviceBuffer<0>(),
+									  (val_t *)temporal3.template getDeviceBuffer<0>(),
+									  is_greater);
+	}
+};
+
+#endif
+
 namespace openfpm
 {
 	template<typename key_t, typename val_t,
@@ -240,9 +299,7 @@ namespace openfpm
 	{
 #ifdef CUDA_ON_CPU
 
-	key_val_it<key_t,val_t> kv(keys_input,vals_input);
-
-	std::sort(kv,kv+count,comp);
+	sort_cpu_impl<openfpm::is_radix_sortable<key_t>::value>::sort(keys_input,vals_input,count,comp,context);
 
 #else
 
@@ -0,0 +1,199 @@
+/*
+ * hilbert.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_UTIL_HILBERT_HPP_
+#define OPENFPM_DATA_SRC_UTIL_HILBERT_HPP_
+
+#include "Grid/grid_key.hpp"
+
+/*! \brief Convert coordinates into the transposed Hilbert index (Skilling's algorithm)
+ *
+ * J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707, 381 (2004).
+ * The loops over the dimensions have compile-time bounds and are unrolled
+ *
+ * \tparam dim dimensionality
+ *
+ * \param X coordinates in input, transposed index in output
+ * \param m order of the curve (bits per coordinate)
+ *
+ */
+template<unsigned int dim>
+inline __device__ __host__ void hilbert_axes_to_transpose(size_t (& X)[dim], size_t m)
+{
+	size_t M = (size_t)1 << (m-1);
+
+	// inverse undo
+
+	for (size_t Q = M ; Q > 1 ; Q >>= 1)
+	{
+		size_t P = Q - 1;
+		for (unsigned int i = 0 ; i < dim ; i++)
+		{
+			if (X[i] & Q)
+			{X[0] ^= P;}
+			else
+			{
+				size_t t = (X[0] ^ X[i]) & P;
+				X[0] ^= t;
+				X[i] ^= t;
+			}
+		}
+	}
+
+	// Gray encode
+
+	for (unsigned int i = 1 ; i < dim ; i++)
+	{X[i] ^= X[i-1];}
+
+	size_t t = 0;
+	for (size_t Q = M ; Q > 1 ; Q >>= 1)
+	{
+		if (X[dim-1] & Q)
+		{t ^= Q - 1;}
+	}
+
+	for (unsigned int i = 0 ; i < dim ; i++)
+	{X[i] ^= t;}
+}
+
+/*! \brief Convert the transposed Hilbert index into coordinates (Skilling's algorithm)
+ *
+ * \tparam dim dimensionality
+ *
+ * \param X transposed index in input, coordinates in output
+ * \param m order of the curve (bits per coordinate)
+ *
+ */
+template<unsigned int dim>
+inline __device__ __host__ void hilbert_transpose_to_axes(size_t (& X)[dim], size_t m)
+{
+	size_t N = (size_t)2 << (m-1);
+
+	// Gray decode
+
+	size_t t = X[dim-1] >> 1;
+	for (unsigned int i = dim-1 ; i > 0 ; i--)
+	{X[i] ^= X[i-1];}
+	X[0] ^= t;
+
+	// undo excess work
+
+	for (size_t Q = 2 ; Q != N ; Q <<= 1)
+	{
+		size_t P = Q - 1;
+		for (int i = dim-1 ; i >= 0 ; i--)
+		{
+			if (X[i] & Q)
+			{X[0] ^= P;}
+			else
+			{
+				t = (X[0] ^ X[i]) & P;
+				X[0] ^= t;
+				X[i] ^= t;
+			}
+		}
+	}
+}
+
+/*! \brief Return the Hilbert key of a point with integer coordinates
+ *
+ * The curve of order m cover the cube [0,2^m)^dim, the key has m*dim bits
+ * (m*dim <= 64). The most significant bits select the sub-cube of the coarsest level
+ *
+ * \tparam dim dimensionality
+ *
+ * \param point coordinates
+ * \param m order of the curve
+ *
+ * \return the Hilbert key
+ *
+ */
+template<unsigned int dim>
+inline __device__ __host__ size_t hilbert_key(const size_t (& point)[dim], size_t m)
+{
+	if (m == 0)	{return 0;}
+
+	size_t X[dim];
+	for (unsigned int i = 0 ; i < dim ; i++)
+	{X[i] = point[i];}
+
+	hilbert_axes_to_transpose<dim>(X,m);
+
+	// interleave, the bit b of X[0] is the most significant of the group b
+
+	size_t key = 0;
+	for (long int b = m-1 ; b >= 0 ; b--)
+	{
+		for (unsigned int i = 0 ; i < dim ; i++)
+		{key = (key << 1) | ((X[i] >> b) & 1);}
+	}
+
+	return key;
+}
+
+/*! \brief Return the integer coordinates of a Hilbert key
+ *
+ * \tparam dim dimensionality
+ *
+ * \param key Hilbert key
+ * \param m order of the curve
+ * \param point coordinates (output)
+ *
+ */
+template<unsigned int dim>
+inline __device__ __host__ void hilbert_point(size_t key, size_t m, size_t (& point)[dim])
+{
+	for (unsigned int i = 0 ; i < dim ; i++)
+	{point[i] = 0;}
+
+	if (m == 0)	{return;}
+
+	for (long int b = m-1 ; b >= 0 ; b--)
+	{
+		for (unsigned int i = 0 ; i < dim ; i++)
+		{point[i] |= ((key >> (b*dim + dim-1-i)) & 1) << b;}
+	}
+
+	hilbert_transpose_to_axes<dim>(point,m);
+}
+
+/*! \brief Linearize a grid key following an Hilbert curve of order m
+ *
+ * \param key grid key (coordinates in [0,2^m))
+ * \param m order of the curve
+ *
+ * \return the Hilbert key
+ *
+ */
+template<unsigned int dim, typename T>
+inline __device__ __host__ size_t lin_hid(const grid_key_dx<dim,T> & key, size_t m)
+{
+	size_t point[dim];
+	for (unsigned int i = 0 ; i < dim ; i++)
+	{point[i] = key.get(i);}
+
+	return hilbert_key<dim>(point,m);
+}
+
+/*! \brief Convert an Hilbert key of order m into a grid key
+ *
+ * \param lin Hilbert key
+ * \param m order of the curve
+ * \param key grid key (output)
+ *
+ */
+template<unsigned int dim, typename T>
+inline __device__ __host__ void invlin_hid(size_t lin, size_t m, grid_key_dx<dim,T> & key)
+{
+	size_t point[dim];
+	hilbert_point<dim>(lin,m,point);
+
+	for (unsigned int i = 0 ; i < dim ; i++)
+	{key.set_d(i,point[i]);}
+}
+
+#endif /* OPENFPM_DATA_SRC_UTIL_HILBERT_HPP_ */
@@ -0,0 +1,152 @@
+/*
+ * cpu_parallel_util_unit_tests.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "util/cpu_parallel_util.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE( cpu_parallel_util_test )
+
+/*! \brief Check scan, reduce, radix sort and bucket sort against serial references
+ *
+ * \param n number of elements
+ *
+ */
+void test_cpu_primitives(size_t n)
+{
+	std::default_random_engine eg;
+	std::uniform_int_distribution<int> ud(-1000000,1000000);
+	std::uniform_real_distribution<float> uf(-1000.0,1000.0);
+
+	// scan and reduce
+
+	std::vector<size_t> in(n);
+	std::vector<size_t> out(n);
+
+	for (size_t i = 0 ; i < n ; i++)
+	{in[i] = ud(eg) & 0xFF;}
+
+	openfpm::cpu_scan(in.data(),n,out.data());
+
+	bool match = true;
+	size_t acc = 0;
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		match &= out[i] == acc;
+		acc += in[i];
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	size_t red = openfpm::cpu_reduce<size_t>(in.data(),n,[](size_t a, size_t b){return a + b;});
+	BOOST_REQUIRE_EQUAL(red,acc);
+
+	// radix sort of signed keys (stable)
+
+	std::vector<int> keys(n);
+	std::vector<size_t> vals(n);
+	std::vector<int> keys_tmp(n);
+	std::vector<size_t> vals_tmp(n);
+
+	std::vector<std::pair<int,size_t>> ref(n);
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		keys[i] = ud(eg) % 5000;
+		vals[i] = i;
+		ref[i] = std::make_pair(keys[i],i);
+	}
+
+	openfpm::cpu_radix_sort_pairs(keys.data(),vals.data(),n,keys_tmp.data(),vals_tmp.data(),false);
+	std::stable_sort(ref.begin(),ref.end(),[](const std::pair<int,size_t> & a, const std::pair<int,size_t> & b){return a.first < b.first;});
+
+	for (size_t i = 0 ; i < n ; i++)
+	{match &= keys[i] == ref[i].first && vals[i] == ref[i].second;}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// radix sort of float keys descending
+
+	std::vector<float> fkeys(n);
+	std::vector<float> fkeys_tmp(n);
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		fkeys[i] = uf(eg);
+		vals[i] = i;
+	}
+
+	std::vector<float> fref = fkeys;
+
+	openfpm::cpu_radix_sort_pairs(fkeys.data(),vals.data(),n,fkeys_tmp.data(),vals_tmp.data(),true);
+	std::sort(fref.begin(),fref.end(),[](float a, float b){return a > b;});
+
+	for (size_t i = 0 ; i < n ; i++)
+	{match &= fkeys[i] == fref[i];}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// bucket sort
+
+	size_t n_bkt = 1000;
+	std::vector<size_t> bkt(n);
+	std::vector<size_t> ele(n);
+	std::vector<size_t> bkt_start(n_bkt+1);
+
+	for (size_t i = 0 ; i < n ; i++)
+	{bkt[i] = (ud(eg) & 0xFFFF) % n_bkt;}
+
+	openfpm::cpu_bucket_sort(bkt.data(),n,n_bkt,ele.data(),bkt_start.data());
+
+	BOOST_REQUIRE_EQUAL(bkt_start[0],0ul);
+	BOOST_REQUIRE_EQUAL(bkt_start[n_bkt],n);
+
+	for (size_t b = 0 ; b < n_bkt ; b++)
+	{
+		for (size_t k = bkt_start[b] ; k < bkt_start[b+1] ; k++)
+		{
+			match &= bkt[ele[k]] == b;
+			match &= (k == bkt_start[b] || ele[k-1] < ele[k]);
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE( cpu_parallel_primitives_over_grain )
+{
+	test_cpu_primitives(5*openfpm::cpu_parallel_grain() + 17);
+}
+
+BOOST_AUTO_TEST_CASE( cpu_parallel_primitives_small_grain )
+{
+	size_t grain = openfpm::cpu_parallel_grain();
+	openfpm::cpu_parallel_grain() = 64;
+
+	test_cpu_primitives(1000);
+	test_cpu_primitives(10007);
+
+	openfpm::cpu_parallel_grain() = grain;
+}
+
+BOOST_AUTO_TEST_CASE( cpu_parallel_radix_sortable )
+{
+	bool test = openfpm::is_radix_sortable<int>::value;
+	BOOST_REQUIRE_EQUAL(test,true);
+
+	test = openfpm::is_radix_sortable<double>::value;
+	BOOST_REQUIRE_EQUAL(test,true);
+
+	test = openfpm::is_radix_sortable<bool>::value;
+	BOOST_REQUIRE_EQUAL(test,false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+/*
+ * hilbert_unit_tests.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "util/hilbert.hpp"
+#include <vector>
+
+/*! \brief Walk the full curve, check that it is a bijection, that start at the origin
+ *         and that two consecutive points are neighbors
+ *
+ * \param m order of the curve
+ *
+ */
+template<unsigned int dim>
+void test_hilbert_curve(size_t m)
+{
+	size_t n = (size_t)1 << (m*dim);
+
+	std::vector<char> seen(n,0);
+	grid_key_dx<dim> prev;
+
+	bool ret = true;
+
+	for (size_t h = 0 ; h < n ; h++)
+	{
+		grid_key_dx<dim> key;
+		invlin_hid(h,m,key);
+
+		size_t lin = 0;
+		for (long int i = dim-1 ; i >= 0 ; i--)
+		{lin = (lin << m) | key.get(i);}
+
+		ret &= (seen[lin] == 0);
+		seen[lin] = 1;
+
+		ret &= (lin_hid(key,m) == h);
+
+		if (h == 0)
+		{
+			for (size_t i = 0 ; i < dim ; i++)
+			{ret &= (key.get(i) == 0);}
+		}
+		else
+		{
+			size_t dist = 0;
+			for (size_t i = 0 ; i < dim ; i++)
+			{dist += std::abs(key.get(i) - prev.get(i));}
+
+			ret &= (dist == 1);
+		}
+
+		prev = key;
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+}
+
+BOOST_AUTO_TEST_SUITE( hilbert_test )
+
+BOOST_AUTO_TEST_CASE( hilbert_curve_2d_3d )
+{
+	for (size_t m = 1 ; m <= 5 ; m++)
+	{
+		test_hilbert_curve<2>(m);
+		test_hilbert_curve<3>(m);
+	}
+
+	test_hilbert_curve<2>(10);
+	test_hilbert_curve<3>(7);
+}
+
+BOOST_AUTO_TEST_CASE( hilbert_curve_nd )
+{
+	test_hilbert_curve<1>(6);
+	test_hilbert_curve<4>(3);
+	test_hilbert_curve<5>(2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()